@@ -1,12 +1,20 @@
 #include "hlt/game.hpp"
 #include "hlt/constants.hpp"
 #include "hlt/log.hpp"
+#include "hlt/input.hpp"
 #include "hlt/utils.hpp"
 #include "hlt/hungarian.hpp"
+#include "hlt/sparse_assignment.hpp"
+#include "hlt/direction_resolver.hpp"
+#include "hlt/cooperative_planner.hpp"
+#include "hlt/assignment_dump.hpp"
+#include "hlt/phase_profile.hpp"
+#include "hlt/random.hpp"
+#include "hlt/thread_pool.hpp"
+#include "hlt/mining.hpp"
 #include "hlt/game_map.hpp"
 #include "hlt/metrics.hpp"
 
-#include <random>
 #include <vector>
 #include <string>
 #include <unordered_set>
@@ -17,12 +25,6 @@ using namespace std;
 using namespace hlt;
 using namespace constants;
 
-double getTime() {
-    timeval tv;
-    gettimeofday(&tv, NULL);
-    return tv.tv_sec + tv.tv_usec * 1e-6;
-}
-
 int dirToInt(Direction d) {
     switch(d) {
         case Direction::NORTH:
@@ -54,6 +56,14 @@ int constants::PID = 0;
 
 typedef VC<Position> Path;
 
+// A returning ship's moves along shortest routes cost 1, RETURN_OPTION_STEP,
+// RETURN_OPTION_STEP^2, ... in the resolver; staying is 1e4 and anything else 1e7.
+const int RETURN_OPTION_STEP = 10;
+// What the cooperative planner charges a returning ship per turn a move loses
+// to the others' routes: one lost turn outweighs taking the next shortest
+// route instead, but never staying or leaving the shortest routes.
+const double RETURN_DELAY_COST = 2 * RETURN_OPTION_STEP;
+
 enum OrderType {
     GATHER,
     RETURN,
@@ -78,8 +88,14 @@ int main(int argc, char* argv[]) {
         rng_seed = static_cast<unsigned int>(time(nullptr));
     }
 
-    mt19937 rng(rng_seed);
+    // main thread stream; worker threads derive their own from the same seed
+    Rng rng(rng_seed);
     bool one_ship = false;
+    bool dump_assignments = false;
+    bool cooperative_routes = false;
+    std::string record_path;
+    std::string replay_path;
+    std::string profile_path;
 
     for (int i = 0; i < argc; i++) {
         log::log(argv[i]);
@@ -99,18 +115,59 @@ int main(int argc, char* argv[]) {
             log::log("Debug mode enabled");
             one_ship = true;
         }
+        else if (std::string(argv[i]) == "--dumpassign") {
+            log::log("Dumping assignment problems");
+            dump_assignments = true;
+        }
+        else if (std::string(argv[i]) == "--coop") {
+            log::log("Cooperative route planning enabled");
+            cooperative_routes = true;
+        }
+        else if (std::string(argv[i]) == "--record" && i + 1 < argc) {
+            record_path = argv[++i];
+            log::log("Recording input to", record_path);
+        }
+        else if (std::string(argv[i]) == "--replay" && i + 1 < argc) {
+            replay_path = argv[++i];
+            log::log("Replaying input from", replay_path);
+        }
+        else if (std::string(argv[i]) == "--profile" && i + 1 < argc) {
+            profile_path = argv[++i];
+            log::log("Writing phase timings to", profile_path);
+        }
         else {
 
         }
     }
 
+    // a replay plays with the seed it was recorded with, and needs the same flags
+    if (!replay_path.empty()) {
+        uint32_t seed;
+        if (!replay_input(replay_path, seed)) {
+            log::log("Could not read replay", replay_path);
+            return 1;
+        }
+        rng_seed = seed;
+        rng.seed(rng_seed);
+    }
+    else if (!record_path.empty() && !record_input(record_path, rng_seed)) {
+        log::log("Could not open recording", record_path);
+    }
+
     log::log("DROPOFFS_ENABLED", constants::DROPOFFS_ENABLED);
     log::log("INSPIRATION_ENABLED", constants::INSPIRATION_ENABLED);
     log::log("DEBUG_ENABLED", constants::IS_DEBUG);
 
     Game game;
 
-    HungarianAlgorithm hungarianAlgorithm;
+    SparseAssignment gatherAssignment;
+    DirectionResolver directionResolver;
+    CooperativePlanner cooperativePlanner;
+    AssignmentDump assignmentDump;
+    AssignmentRecord assignmentRecord;
+    PhaseProfile phaseProfile;
+    ThreadPool rolloutPool;
+    log::log("Rollout threads", rolloutPool.size());
 
     // INIT
     bool is_1v1 = game.players.size() == 2;
@@ -127,16 +184,31 @@ int main(int argc, char* argv[]) {
     game.ready("adbv138");
     log::log("Successfully created bot! My Player ID is " + to_string(game.my_id) + ". Bot rng seed is " + to_string(rng_seed) + ".");
     constants::PID = game.my_id;
+    if (dump_assignments) {
+        assignmentDump.open("assignments-" + to_string(game.my_id) + ".bin");
+    }
+    if (!profile_path.empty() && !phaseProfile.open(profile_path)) {
+        log::log("Could not open profile", profile_path);
+    }
     Metrics::init(&game);
+    cooperativePlanner.resize(game.game_map->width, game.game_map->height);
 
     Timer turnTimer;
 
     bool DROPOFF_PLANNED = false;
     shared_ptr<Dropoff> fake_drop = nullptr;
+    // Player::_update drops it with the other fake dropoffs, it goes back in every turn
+    shared_ptr<Dropoff> shipyard_drop = make_shared<Dropoff>(game.me->id, -3000, game.me->shipyard->position.x,
+                                                             game.me->shipyard->position.y);
 
     for (;;) {
+        // the wait for the engine is not part of the parse
+        wait_for_input();
+        double frame_start = getTime();
         game.update_frame();
         turnTimer.start();
+        phaseProfile.start_turn(game.turn_number, game.me->ships.size());
+        phaseProfile.add("parse", turnTimer.startTime - frame_start);
 
         shared_ptr<Player> me = game.me;
         shared_ptr<Player> opponent = game.players[0];
@@ -169,7 +241,7 @@ int main(int argc, char* argv[]) {
         int remaining_hal_per_ship = game_map->get_hal() / total_ships;
 
         // Add shipyard to dropoffs
-        me->dropoffs[-3000] = make_shared<Dropoff>(me->id, -3000, me->shipyard->position.x, me->shipyard->position.y);
+        me->dropoffs[-3000] = shipyard_drop;
 
         map<EntityId, Order> ordersMap;
 
@@ -242,6 +314,7 @@ int main(int argc, char* argv[]) {
         double halite_per_ship_turn = Metrics::getHalPerShipEma();
 
         log::log("Before BFS", turnTimer.elapsed());
+        phaseProfile.mark("setup", turnTimer.elapsed());
         map<Position, BFSR> ship_to_dist;
         map<Position, BFSR> col_ship_to_dist;
         map<Position, BFSR> &greedy_bfs = ship_to_dist;
@@ -257,6 +330,7 @@ int main(int argc, char* argv[]) {
 
         set<EntityId> given_order;
         log::log("Time -- Before dropoffs", turnTimer.elapsed());
+        phaseProfile.mark("bfs", turnTimer.elapsed());
         // Cancel a dropoff
 
         auto dropoff_permissible = [&](Position curr) -> bool {
@@ -405,6 +479,7 @@ int main(int argc, char* argv[]) {
         }
 
         log::log("After BFS", turnTimer.elapsed());
+        phaseProfile.mark("dropoffs", turnTimer.elapsed());
         set<EntityId> added;
 
         // RETURNING SHIPS
@@ -427,8 +502,8 @@ int main(int argc, char* argv[]) {
 
                 }
                 else {
-                    VVP &pars = col_ship_to_dist[ship->position].parent;
-                    int dist = game_map->getPathLength(pars, ship->position, dropoff.second->position);
+                    BFSR &bfs = col_ship_to_dist[ship->position];
+                    int dist = game_map->getPathLength(bfs, ship->position, dropoff.second->position);
                     if (dist == -1) {
                         dist = 5 * game_map->calculate_distance(ship->position, dropoff.second->position);
                     }
@@ -459,7 +534,7 @@ int main(int argc, char* argv[]) {
             auto state = stateMp[ship->id];
             auto mdest = game_map->closest_dropoff(ship->position, &game);
 
-            VVP &pars = col_ship_to_dist[ship->position].parent;
+            BFSR &bfs = col_ship_to_dist[ship->position];
             if (state != SUPER_RETURN) {
                 Position best_drop = me->shipyard->position;
                 int best_cost = game_map->calculate_distance(me->shipyard->position, ship->position);
@@ -467,7 +542,7 @@ int main(int argc, char* argv[]) {
                     if (can_see_fake_drop.count(ship->id) == 0) {
                         if (dropoff.second->is_fake) continue;
                     }
-                    int dist = game_map->getPathLength(pars, ship->position, dropoff.second->position);
+                    int dist = game_map->getPathLength(bfs, ship->position, dropoff.second->position);
                     if (dist == -1) {
                         dist = 5 * game_map->calculate_distance(ship->position, dropoff.second->position);
                     }
@@ -481,13 +556,13 @@ int main(int argc, char* argv[]) {
 
 
             vector<Direction> options;
-            options = game_map->minCostOptions(pars, ship->position, mdest);
+            options = game_map->minCostOptions(bfs, ship->position, mdest);
 
             if (state == RETURNING) {
                 log::flog(log::Log{game.turn_number - 1, ship->position.x, ship->position.y, "returning", "#0000FF"});
                 int hal_on_square = game_map->at(ship->position)->halite;
                 if (hal_on_square >= game_map->get_mine_threshold()) {
-                    if (hal_on_square * 0.25 + ship->halite < 1000) {
+                    if (mining::extract(hal_on_square) + ship->halite < 1000) {
                         auto stay_opts = vector<Direction>{1, Direction::STILL};
                         stay_opts.insert(stay_opts.end(), options.begin(), options.end());
 
@@ -509,12 +584,13 @@ int main(int argc, char* argv[]) {
                 int cost = 1;
                 for (auto c : options) {
                     o.add_dir_priority(c, cost);
-                    cost *= 10;
+                    cost *= RETURN_OPTION_STEP;
                 }
                 ordersMap[ship->id] = o;
             }
         }
         log::log("After costs filled ", turnTimer.elapsed());
+        phaseProfile.mark("returning", turnTimer.elapsed());
 
         // Fill ship costs
         struct Cost {
@@ -529,13 +605,12 @@ int main(int argc, char* argv[]) {
         log::log("Start gathering");
         log::log("Ship size", me->ships.size());
 
-        VC<VC<double>> costMatrix;
-        costMatrix.reserve(num_gathering_ships);
         map<int, Ship *> asnMp;
         set<Ship *> frozen;
 
 
         vector<vector<pair<double, Position>>> candidates;
+        vector<int> candidate_ids;
         int ship_count = 0;
         for (auto s : me->ships) {
             shared_ptr<Ship> ship = s.second;
@@ -591,84 +666,111 @@ int main(int argc, char* argv[]) {
                 log::log(turnTimer.elapsed());
                 auto pos = candidate_squares[i].second;
                 Order o;
-                auto walk = game_map->get_best_random_walk(ship->halite, ship->position, pos, o, -1);
+                auto walk = game_map->get_best_random_walk(ship->halite, ship->position, pos, o, rng, -1);
                 candidate_squares[i] = make_pair(100000 - 100 * walk.cost, pos);
             }
             log::log("Done Walking");*/
             candidates.push_back(candidate_squares);
+            candidate_ids.push_back(id);
         }
 
-        // Compress states for hungarian assignment
-        multimap<Position, int> posToInd;
-        map<int, Position> indToPos;
-        int pos_counter = 0;
-        int ship_counter = 0;
-        for (auto shipc : candidates) {
-            multiset<Position> cand_map;
-            for (auto c : shipc) {
-                cand_map.insert(c.second);
-            }
-            for (auto c : shipc) {
-                if (posToInd.count(c.second) < cand_map.count(c.second)) {
-                    posToInd.insert(make_pair(c.second, pos_counter));
-                    indToPos[pos_counter] = c.second;
-                    ++pos_counter;
-                }
-            }
-            ship_counter++;
-        }
-
-        ship_counter = 0;
-        for (auto shipc : candidates) {
-            costMatrix.push_back(vector<double>(pos_counter, 1e9));
-            for (auto c : shipc) {
-                auto range = posToInd.equal_range(c.second);
-                for (auto itr = range.first; itr != range.second; itr++) {
-                    costMatrix.at(ship_counter).at(itr->second) = c.first;
-                }
-            }
-            ship_counter++;
-        }
-
-        vector<int> assgn(me->ships.size(), 0);
-        int count = 0;
-        if (costMatrix.size() != 0) {
+        vector<Position> assgn;
+        if (candidates.size() != 0) {
             double timelim = 1.8;
             if (IS_DEBUG) {
                 timelim = 0.1;
             }
 
-            double remaining = (timelim - turnTimer.elapsed()) / (ship_counter - count);
-            count++;
+            // the assignment gets a quarter of what is left, the walks get the rest
+            double assign_deadline = turnTimer.elapsed() + 0.25 * (timelim - turnTimer.elapsed());
             log::log(1.9 - turnTimer.elapsed());
-            log::log(costMatrix.size(), costMatrix[0].size());
+            log::log(candidates.size(), candidates[0].size());
+            if (assignmentDump.is_open()) {
+                int cells = game_map->width * game_map->height;
+                assignmentRecord.clear(AssignmentRecord::GATHER, game.turn_number, cells);
+                for (int r = 0; r < (int)candidates.size(); r++) {
+                    for (auto &c : candidates[r]) {
+                        assignmentRecord.add_edge(c.second.y * game_map->width + c.second.x, c.first);
+                    }
+                    assignmentRecord.end_row(candidate_ids[r]);
+                }
+                assignmentDump.write(assignmentRecord);
+            }
             log::log("Before hungarian ", turnTimer.elapsed());
-            hungarianAlgorithm.Solve(costMatrix, assgn);
+            phaseProfile.mark("gather_costs", turnTimer.elapsed());
+            gatherAssignment.solve(candidates, assgn, turnTimer, assign_deadline);
             log::log("After hungarian ", turnTimer.elapsed());
+            phaseProfile.mark("assignment", turnTimer.elapsed());
+            if (!gatherAssignment.was_exact) {
+                log::log("Assignment deadline hit, using heuristic matching");
+            }
+
+            vector<Ship *> walkShips;
+            vector<Position> walkDests;
+            vector<Order> walkOrders;
             for (auto i : asnMp) {
                 log::log("Ship ", i.second->id);
                 auto ship = i.second;
-                auto mdest = indToPos[assgn[i.first]];
+                auto mdest = assgn[i.first];
+                if (mdest == Position{-1, -1}) {
+                    mdest = ship->position;
+                }
 
                 log::flog(log::Log{game.turn_number - 1, mdest.x, mdest.y, "gather - " + std::to_string(ship->id), "#FF0000"});
                 log::flog(log::Log{game.turn_number - 1, ship->position.x, ship->position.y,
                                    "Going to - " + to_string(mdest.x) + " " + to_string(mdest.y), "#FFFFFF"});
 
                 vector<Direction> options;
-                options = game_map->minCostOptions(greedy_bfs[ship->position].parent, ship->position, mdest);
+                options = game_map->minCostOptions(greedy_bfs[ship->position], ship->position, mdest);
                 Order o{10, GATHERING, ship, mdest};
                 o.setAllCosts(1e8);
-                auto walk = game_map->get_best_random_walk(ship->halite, ship->position, mdest, o, fmax(0.001, remaining));
+                walkShips.push_back(ship);
+                walkDests.push_back(mdest);
+                walkOrders.push_back(o);
+            }
+
+            // Rollouts for all assigned ships run on the pool. Every ship that needs
+            // fresh rollouts gets an equal share of the time left (scaled by the worker
+            // count); cached ones only run a short top-up. The share assumes every
+            // worker has a core to itself, so each task also stops at the turn's
+            // rollout deadline in case fewer are really there. Each ship has its own
+            // rng stream, so a ship's result does not depend on which worker ran it.
+            game_map->prepare_rollouts();
+            int fresh = 0;
+            for (int t = 0; t < (int)walkShips.size(); t++) {
+                if (!game_map->has_cached_walk(walkShips[t]->halite, walkShips[t]->position, walkDests[t],
+                                               walkShips[t]->id)) fresh++;
+            }
+            log::log("Cached walks", (int)walkShips.size() - fresh, walkShips.size());
+            double left = timelim - turnTimer.elapsed();
+            double remaining = fmin(left, left * rolloutPool.size() / max(1, fresh));
+            double rollout_deadline = getTime() + left;
+
+            vector<RandomWalkResult> walks(walkShips.size());
+            rolloutPool.run((int)walkShips.size(), [&](int t, int) {
+                Ship *ship = walkShips[t];
+                Rng walkRng(rng_seed, ((uint64_t)game.turn_number << 32) | (uint32_t)ship->id);
+                double bank = fmin(remaining, rollout_deadline - getTime());
+                walks[t] = game_map->get_best_random_walk(ship->halite, ship->position, walkDests[t], walkOrders[t],
+                                                          walkRng, fmax(0.0001, bank));
+            });
+
+            // merge in assignment order
+            for (int t = 0; t < (int)walkShips.size(); t++) {
+                Ship *ship = walkShips[t];
+                Order &o = walkOrders[t];
                 log::log(ship->id);
-                log::log("val of best", walk.cost);
+                log::log("val of best", walks[t].cost);
                 // game_map->addPlanned(0, walk.walk);
                 added.insert(ship->id);
-                claimed.insert(mdest);
-                o.add_dir_priority(walk.bestdir, 1);
+                claimed.insert(walkDests[t]);
+                o.add_dir_priority(walks[t].bestdir, 1);
                 ordersMap[ship->id] = o;
             }
         }
         log::log("After random walks", turnTimer.elapsed());
+        phaseProfile.mark("rollouts", turnTimer.elapsed());
+        log::log("Plans followed, replanned ", game_map->ship_plans.followed, game_map->ship_plans.replanned);
 
         for (const auto &ship_iterator : me->ships) {
             shared_ptr<Ship> ship = ship_iterator.second;
@@ -701,25 +803,22 @@ int main(int argc, char* argv[]) {
             }
         }
 
-        map<Position, int> bijectToPos;
-        indToPos.clear();
-        int ind = 0;
-        for (auto s : me->ships) {
-            for (auto p : game_map->get_surrounding_pos(s.second->position)) {
-                if (!bijectToPos.count(p)) {
-                    bijectToPos[p] = ind;
-                    indToPos[ind] = p;
-                    ind++;
-                }
-            }
-        }
-
         log::log("Starting resolve phase", turnTimer.elapsed());
-        vector<vector<double>> directionCostMatrix(me->ships.size(), vector<double>(ind, 1e30));
-        int i = 0;
+        phaseProfile.mark("orders", turnTimer.elapsed());
+        directionResolver.clear();
+        if (assignmentDump.is_open()) {
+            assignmentRecord.clear(AssignmentRecord::RESOLVE, game.turn_number, game_map->width * game_map->height);
+        }
+        if (cooperative_routes) {
+            cooperativePlanner.begin_turn(game.turn_number);
+        }
+        map<EntityId, int> dirRows;
+        vector<pair<Ship *, array<double, 5>>> resolveRows;
+        vector<int> planAgents;
         for (auto s : me->ships) {
             auto ship = s.second;
             auto state = stateMp[ship->id];
+            bool has_order = ordersMap.count(ship->id) > 0;
 
             auto response = EnemyResponse::SMART;
             if (!is_1v1) {
@@ -740,7 +839,7 @@ int main(int argc, char* argv[]) {
                 response = IGNORE;
             }
 
-            for (auto d : ship->GetBannedDirs(game_map.get(), response, game)) {
+            for (auto d : ship->GetBannedDirs(game_map.get(), response, game, rng)) {
                 double cost = 1e12;
                 if (d == Direction::STILL) {
                     cost = 1e13;
@@ -753,13 +852,13 @@ int main(int argc, char* argv[]) {
                 // Don't include
                 command_queue.push_back(ship->move(game_map->get_unsafe_moves(ship->position, drop)[0]));
                 given_order.insert(ship->id);
-                i++;
                 continue;
             }
 
-            for (auto d : ALL_DIRS) {
+            array<double, 5> costs;
+            for (int k = 0; k < (int)ALL_DIRS.size(); k++) {
+                auto d = ALL_DIRS[k];
                 Position p = game_map->normalize(ship->position.directional_offset(d));
-                int ind = bijectToPos[p];
 
                 if (game_map->closest_dropoff(ship->position, &game) == p) {
                     if (d == Direction::STILL) {
@@ -767,26 +866,71 @@ int main(int argc, char* argv[]) {
                     }
                 }
 
-                directionCostMatrix[i][ind] = ordersMap[ship->id].nextCosts[d];
+                costs[k] = ordersMap[ship->id].nextCosts[d];
+            }
+
+            // With --coop, frozen ships plan first and gathering ships keep the move their
+            // rollouts picked; both only reserve. Returning ships pay for every
+            // turn the others' routes would cost them. Ships headed for a dropoff
+            // move on once they get there, everyone else stays put.
+            if (cooperative_routes) {
+                Position dest = has_order ? game_map->normalize(ordersMap[ship->id].planned_dest) : game_map->normalize(ship->position);
+                int rank = 1;
+                double delay_cost = 0;
+                if (assigned.count(ship.get())) {
+                    rank = 0;
+                }
+                else if (state == RETURNING) {
+                    rank = 2;
+                    delay_cost = RETURN_DELAY_COST;
+                }
+                bool holds_dest = state != RETURNING && state != SUPER_RETURN;
+                planAgents.push_back(cooperativePlanner.add_agent(ship->id, game_map->normalize(ship->position), dest,
+                                                                  costs, delay_cost, rank, holds_dest));
+            }
+            resolveRows.push_back(make_pair(ship.get(), costs));
+        }
+        if (cooperative_routes) {
+            cooperativePlanner.plan();
+            log::log("Planned routes ", cooperativePlanner.planned(), turnTimer.elapsed());
+            for (int i = 0; i < (int)resolveRows.size(); i++) {
+                for (int k = 0; k < (int)ALL_DIRS.size(); k++) {
+                    resolveRows[i].second[k] = cooperativePlanner.cost(planAgents[i], k);
+                }
+            }
+        }
+
+        for (auto &row : resolveRows) {
+            Ship *ship = row.first;
+            array<pair<Position, double>, 5> options;
+            for (int k = 0; k < (int)ALL_DIRS.size(); k++) {
+                Position p = game_map->normalize(ship->position.directional_offset(ALL_DIRS[k]));
+                options[k] = make_pair(p, row.second[k]);
+            }
+            dirRows[ship->id] = directionResolver.add_ship(options);
+            if (assignmentDump.is_open()) {
+                for (auto &o : options) {
+                    assignmentRecord.add_edge(o.first.y * game_map->width + o.first.x, o.second);
+                }
+                assignmentRecord.end_row(ship->id);
             }
-            i++;
+        }
+        if (assignmentDump.is_open() && assignmentRecord.rows() > 0) {
+            assignmentDump.write(assignmentRecord);
         }
         log::log("After Dir Assignment ", turnTimer.elapsed());
 
-        vector<int> dirShipMapping(me->ships.size());
-        if (me->ships.size() > 0) {
-            hungarianAlgorithm.Solve(directionCostMatrix, dirShipMapping);
-        }
+        directionResolver.build_components();
+        directionResolver.solve();
+        log::log("Resolved components ", directionResolver.components(), turnTimer.elapsed());
+        phaseProfile.mark("resolve", turnTimer.elapsed());
 
-        i = 0;
         for (auto s : me->ships) {
             auto ship = s.second;
             if (given_order.count(ship->id)) {
-                i++;
                 continue;
             }
-            int ind = dirShipMapping[i];
-            Position move = indToPos[ind];
+            Position move = directionResolver.result(dirRows[ship->id]);
             auto dir = game_map->getDirectDiff(game_map->normalize(ship->position), game_map->normalize(move));
 
             auto state = stateMp[ship->id];
@@ -801,7 +945,6 @@ int main(int argc, char* argv[]) {
 
             ship->planned_next = ship->position.directional_offset(dir);
             command_queue.push_back(ship->move(dir));
-            i++;
         }
 
         log::log("Starting logging phase");
@@ -878,6 +1021,8 @@ int main(int argc, char* argv[]) {
 
 
         bool end_turn = !game.end_turn(command_queue);
+        phaseProfile.mark("commands", turnTimer.elapsed());
+        phaseProfile.end_turn();
         log::log(turnTimer.tostring());
         log::log("Score (halite, ships, dropoffs)");
         log::log("Me: ", me->halite, me->ships.size(), me->dropoffs.size());
@@ -0,0 +1,442 @@
+// Replays recorded assignment problems (see hlt/assignment_dump.hpp, written by
+// MyBot --dumpassign) through every solver we have and reports latency
+// percentiles, heap allocations per solve and how far each solver's objective
+// is from the reference HungarianAlgorithm.
+//
+// usage: assignment_bench [--reps N] files...
+//
+// benchmarks/assignment holds one 32x32 2p, one 48x48 4p and one 64x64 2p game,
+// thinned to every 5th turn for resolves. Gathers are kept for 10 consecutive
+// mid game turns of each (around 30, 50 and 75 ships), so a solver that
+// carries anything from one turn to the next meets real successive problems.
+//
+// Timings include building the solver's input from the per ship candidate
+// lists, since that is what the bot pays every turn. Allocations only count
+// the solver's own solve call, after one untimed pass over the game, so a
+// solver that keeps its workspace between problems shows 0.
+
+#include "hlt/assignment_dump.hpp"
+#include "hlt/hungarian.hpp"
+#include "hlt/sparse_assignment.hpp"
+#include "hlt/direction_resolver.hpp"
+#include "hlt/constants.hpp"
+#include "hlt/utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+bool constants::IS_DEBUG = false;
+
+// Allocation counting. With glibc every allocation, operator new included,
+// ends up in malloc, so that is the one place to count.
+static long long allocations = 0;
+
+#ifdef __GLIBC__
+extern "C" {
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t n, size_t size);
+    void *__libc_realloc(void *p, size_t size);
+
+    void *malloc(size_t size) {
+        allocations++;
+        return __libc_malloc(size);
+    }
+
+    void *calloc(size_t n, size_t size) {
+        allocations++;
+        return __libc_calloc(n, size);
+    }
+
+    void *realloc(void *p, size_t size) {
+        allocations++;
+        return __libc_realloc(p, size);
+    }
+}
+#else
+void *operator new(size_t size) {
+    allocations++;
+    void *p = std::malloc(size ? size : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+#endif
+
+// allocations made inside solver calls wrapped in counted()
+static long long solve_allocations = 0;
+
+template<typename F>
+static void counted(F f) {
+    long long before = allocations;
+    f();
+    solve_allocations += allocations - before;
+}
+
+static const double MISSING = 1e9;
+
+// One recorded problem in the form the bot hands to the solvers.
+struct Problem {
+    const AssignmentRecord *record;
+    vector<vector<pair<double, Position>>> candidates;
+    vector<array<pair<Position, double>, 5>> options;
+};
+
+// A solver maps a problem to one column (cell index) per row, -1 if unmatched.
+struct Solver {
+    string name;
+    int kind;
+    // called once per file pass so a solver that keeps state between calls starts
+    // fresh on each game
+    function<void()> reset;
+    function<void(const Problem &, vector<int> &)> solve;
+};
+
+static Position cell_position(int col) {
+    return Position(col, 0);
+}
+
+// Dense rows x slots matrix the way the bot used to build it: a position listed
+// k times by one row gets k columns and every row listing it sees all of them.
+static void build_gather_matrix(const Problem &p, vector<double> &matrix, vector<int> &slot_col) {
+    map<int, int> slots;
+    map<int, int> uses;
+    for (auto &row : p.candidates) {
+        uses.clear();
+        for (auto &c : row) {
+            int col = c.second.x;
+            slots[col] = max(slots[col], ++uses[col]);
+        }
+    }
+    map<int, int> first;
+    slot_col.clear();
+    for (auto &s : slots) {
+        first[s.first] = (int)slot_col.size();
+        slot_col.insert(slot_col.end(), s.second, s.first);
+    }
+
+    int n = (int)slot_col.size();
+    matrix.assign(p.candidates.size() * n, MISSING);
+    for (int r = 0; r < (int)p.candidates.size(); r++) {
+        for (auto &c : p.candidates[r]) {
+            int col = c.second.x;
+            for (int k = 0; k < slots[col]; k++) {
+                matrix[r * n + first[col] + k] = c.first;
+            }
+        }
+    }
+}
+
+static void build_resolve_matrix(const Problem &p, vector<double> &matrix, vector<int> &slot_col) {
+    map<int, int> index;
+    slot_col.clear();
+    for (auto &o : p.options) {
+        for (auto &c : o) {
+            if (!index.count(c.first.x)) {
+                index[c.first.x] = (int)slot_col.size();
+                slot_col.push_back(c.first.x);
+            }
+        }
+    }
+    int n = (int)slot_col.size();
+    matrix.assign(p.options.size() * n, 1e30);
+    for (int r = 0; r < (int)p.options.size(); r++) {
+        for (auto &c : p.options[r]) {
+            matrix[r * n + index[c.first.x]] = c.second;
+        }
+    }
+}
+
+static void to_cells(const vector<int> &assignment, const vector<int> &slot_col, vector<int> &out) {
+    out.resize(assignment.size());
+    for (int r = 0; r < (int)assignment.size(); r++) {
+        out[r] = assignment[r] < 0 ? -1 : slot_col[assignment[r]];
+    }
+}
+
+static void to_cells(const vector<Position> &assignment, vector<int> &out) {
+    out.resize(assignment.size());
+    for (int r = 0; r < (int)assignment.size(); r++) {
+        out[r] = assignment[r].x;
+    }
+}
+
+static vector<Solver> make_solvers() {
+    vector<Solver> solvers;
+    auto nested_matrix = make_shared<vector<vector<double>>>();
+    auto matrix = make_shared<vector<double>>();
+    auto slot_col = make_shared<vector<int>>();
+    auto assignment = make_shared<vector<int>>();
+    auto positions = make_shared<vector<Position>>();
+    auto hungarian = make_shared<HungarianAlgorithm>();
+    auto workspace = make_shared<HungarianWorkspace>();
+    auto sparse = make_shared<SparseAssignment>();
+    auto resolver = make_shared<DirectionResolver>();
+    auto nothing = [] {};
+
+    auto nested = [=](const vector<double> &m, int rows, vector<int> &out) {
+        int cols = rows == 0 ? 0 : (int)m.size() / rows;
+        nested_matrix->assign(rows, vector<double>(cols));
+        for (int r = 0; r < rows; r++) {
+            copy(m.begin() + r * cols, m.begin() + (r + 1) * cols, (*nested_matrix)[r].begin());
+        }
+        counted([&] { hungarian->Solve(*nested_matrix, *assignment); });
+        to_cells(*assignment, *slot_col, out);
+    };
+    auto flat = [=](const vector<double> &m, int rows, vector<int> &out) {
+        int cols = rows == 0 ? 0 : (int)m.size() / rows;
+        counted([&] { hungarian->Solve(m.data(), rows, cols, cols, *assignment, *workspace); });
+        to_cells(*assignment, *slot_col, out);
+    };
+
+    int gather = AssignmentRecord::GATHER;
+    int resolve = AssignmentRecord::RESOLVE;
+
+    solvers.push_back({"hungarian", gather, nothing, [=](const Problem &p, vector<int> &out) {
+        build_gather_matrix(p, *matrix, *slot_col);
+        nested(*matrix, (int)p.candidates.size(), out);
+    }});
+    solvers.push_back({"hungarian_flat", gather, nothing, [=](const Problem &p, vector<int> &out) {
+        build_gather_matrix(p, *matrix, *slot_col);
+        flat(*matrix, (int)p.candidates.size(), out);
+    }});
+    solvers.push_back({"sparse", gather, nothing, [=](const Problem &p, vector<int> &out) {
+        counted([&] { sparse->solve(p.candidates, *positions); });
+        to_cells(*positions, out);
+    }});
+    solvers.push_back({"sparse_greedy", gather, nothing, [=](const Problem &p, vector<int> &out) {
+        // a deadline that has already passed leaves only the heuristic matching
+        Timer timer;
+        counted([&] { sparse->solve(p.candidates, *positions, timer, -1); });
+        to_cells(*positions, out);
+    }});
+
+    solvers.push_back({"hungarian", resolve, nothing, [=](const Problem &p, vector<int> &out) {
+        build_resolve_matrix(p, *matrix, *slot_col);
+        nested(*matrix, (int)p.options.size(), out);
+    }});
+    solvers.push_back({"hungarian_flat", resolve, nothing, [=](const Problem &p, vector<int> &out) {
+        build_resolve_matrix(p, *matrix, *slot_col);
+        flat(*matrix, (int)p.options.size(), out);
+    }});
+    solvers.push_back({"resolver", resolve, nothing, [=](const Problem &p, vector<int> &out) {
+        resolver->clear();
+        for (auto &o : p.options) {
+            resolver->add_ship(o);
+        }
+        counted([&] {
+            resolver->build_components();
+            resolver->solve();
+        });
+        out.resize(p.options.size());
+        for (int r = 0; r < (int)p.options.size(); r++) {
+            out[r] = resolver->result(r).x;
+        }
+    }});
+    return solvers;
+}
+
+static Problem make_problem(const AssignmentRecord &record) {
+    Problem p;
+    p.record = &record;
+    for (int r = 0; r < record.rows(); r++) {
+        if (record.kind == AssignmentRecord::GATHER) {
+            p.candidates.emplace_back();
+            for (int e = record.row_start[r]; e < record.row_start[r + 1]; e++) {
+                p.candidates.back().push_back(make_pair(record.edge_cost[e], cell_position(record.edge_col[e])));
+            }
+        }
+        else {
+            array<pair<Position, double>, 5> o;
+            for (int e = record.row_start[r], k = 0; e < record.row_start[r + 1] && k < 5; e++, k++) {
+                o[k] = make_pair(cell_position(record.edge_col[e]), record.edge_cost[e]);
+            }
+            p.options.push_back(o);
+        }
+    }
+    return p;
+}
+
+struct Outcome {
+    double cost = 0;
+    int unmatched = 0;
+    bool valid = true;
+};
+
+// Scores an assignment against the record's own edges. Rows sent to a cell they
+// never listed count as unmatched; a cell may take as many rows as its slots.
+static Outcome evaluate(const AssignmentRecord &record, const vector<int> &cells) {
+    Outcome out;
+    map<int, int> capacity;
+    map<int, int> taken;
+    for (int r = 0; r < record.rows(); r++) {
+        map<int, int> uses;
+        for (int e = record.row_start[r]; e < record.row_start[r + 1]; e++) {
+            int col = record.edge_col[e];
+            capacity[col] = max(capacity[col], record.kind == AssignmentRecord::GATHER ? ++uses[col] : 1);
+        }
+    }
+    for (int r = 0; r < record.rows(); r++) {
+        double best = -1;
+        bool listed = false;
+        for (int e = record.row_start[r]; e < record.row_start[r + 1]; e++) {
+            if (record.edge_col[e] == cells[r] && record.edge_cost[e] < MISSING) {
+                best = listed ? min(best, record.edge_cost[e]) : record.edge_cost[e];
+                listed = true;
+            }
+        }
+        if (!listed) {
+            out.unmatched++;
+            continue;
+        }
+        out.cost += best;
+        if (++taken[cells[r]] > capacity[cells[r]]) {
+            out.valid = false;
+        }
+    }
+    return out;
+}
+
+struct Stats {
+    vector<double> micros;
+    long long allocations = 0;
+    long long solves = 0;
+    int disagreements = 0;
+    int invalid = 0;
+    double gap = 0;
+};
+
+static double percentile(vector<double> &v, double q) {
+    if (v.empty()) return 0;
+    size_t k = min(v.size() - 1, (size_t)(q * (v.size() - 1) + 0.5));
+    nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+static const char *bucket_name(int rows) {
+    if (rows < 16) return "1-15";
+    if (rows < 32) return "16-31";
+    if (rows < 64) return "32-63";
+    return "64+";
+}
+
+int main(int argc, char *argv[]) {
+    int reps = 5;
+    vector<string> files;
+    for (int i = 1; i < argc; i++) {
+        if (string(argv[i]) == "--reps" && i + 1 < argc) {
+            reps = max(1, atoi(argv[++i]));
+        }
+        else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.empty()) {
+        fprintf(stderr, "usage: %s [--reps N] files...\n", argv[0]);
+        return 1;
+    }
+
+    vector<vector<AssignmentRecord>> games(files.size());
+    int total = 0;
+    for (int f = 0; f < (int)files.size(); f++) {
+        if (!AssignmentDump::read(files[f], games[f])) {
+            fprintf(stderr, "could not read %s\n", files[f].c_str());
+            return 1;
+        }
+        total += (int)games[f].size();
+    }
+    printf("%d problems from %d files, %d reps\n\n", total, (int)files.size(), reps);
+
+    vector<Solver> solvers = make_solvers();
+    // (kind, solver, bucket) -> stats, "all" bucket included
+    map<tuple<int, int, string>, Stats> stats;
+    vector<int> cells;
+
+    for (int f = 0; f < (int)games.size(); f++) {
+        vector<Problem> problems;
+        for (auto &record : games[f]) {
+            problems.push_back(make_problem(record));
+        }
+
+        // reference objective per problem from the nested vector hungarian
+        vector<Outcome> reference(problems.size());
+        for (int s = 0; s < (int)solvers.size(); s++) {
+            if (solvers[s].name != "hungarian") continue;
+            for (int i = 0; i < (int)problems.size(); i++) {
+                if (problems[i].record->kind != solvers[s].kind) continue;
+                solvers[s].solve(problems[i], cells);
+                reference[i] = evaluate(*problems[i].record, cells);
+            }
+        }
+
+        for (int s = 0; s < (int)solvers.size(); s++) {
+            Solver &solver = solvers[s];
+            // one untimed pass first, so buffers kept between solves are already
+            // sized for the game the way they are a few turns in
+            solver.reset();
+            for (int i = 0; i < (int)problems.size(); i++) {
+                if (problems[i].record->kind == solver.kind) solver.solve(problems[i], cells);
+            }
+            for (int rep = 0; rep < reps; rep++) {
+                solver.reset();
+                for (int i = 0; i < (int)problems.size(); i++) {
+                    const AssignmentRecord &record = *problems[i].record;
+                    if (record.kind != solver.kind) continue;
+
+                    long long before = solve_allocations;
+                    auto start = chrono::steady_clock::now();
+                    solver.solve(problems[i], cells);
+                    auto end = chrono::steady_clock::now();
+                    long long allocs = solve_allocations - before;
+                    double micros = chrono::duration<double, micro>(end - start).count();
+
+                    Outcome outcome = evaluate(record, cells);
+                    bool agrees = outcome.unmatched == reference[i].unmatched
+                                  && fabs(outcome.cost - reference[i].cost) <= 1e-6 * fmax(1.0, fabs(reference[i].cost));
+                    double gap = outcome.unmatched == reference[i].unmatched ? outcome.cost - reference[i].cost : 0;
+
+                    for (string bucket : {string("all"), string(bucket_name(record.rows()))}) {
+                        Stats &st = stats[make_tuple(record.kind, s, bucket)];
+                        st.micros.push_back(micros);
+                        st.allocations += allocs;
+                        st.solves++;
+                        if (rep == 0) {
+                            st.disagreements += !agrees;
+                            st.invalid += !outcome.valid;
+                            st.gap += gap;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    printf("%-8s %-15s %-6s %7s %10s %10s %10s %10s %10s %9s %7s %12s\n", "kind", "solver", "ships", "count",
+           "p50 us", "p95 us", "p99 us", "max us", "allocs", "disagree", "invalid", "sum gap");
+    for (auto &entry : stats) {
+        int kind = get<0>(entry.first);
+        Stats &st = entry.second;
+        long long problems = st.solves / reps;
+        printf("%-8s %-15s %-6s %7lld %10.1f %10.1f %10.1f %10.1f %10.1f %9d %7d %12.1f\n",
+               kind == AssignmentRecord::GATHER ? "gather" : "resolve", solvers[get<1>(entry.first)].name.c_str(),
+               get<2>(entry.first).c_str(), problems, percentile(st.micros, 0.5), percentile(st.micros, 0.95),
+               percentile(st.micros, 0.99), percentile(st.micros, 1.0), (double)st.allocations / st.solves,
+               st.disagreements, st.invalid, st.gap);
+    }
+    return 0;
+}
@@ -0,0 +1,192 @@
+// Replays recorded games (MyBot --record) through the bot with no engine
+// attached and reports how long each phase of the turn took, as latency
+// percentiles per turn and ship count.
+//
+// usage: turn_bench [--reps N] [--bot PATH] [--json FILE] recordings... [-- bot flags]
+//
+// Every rep starts a fresh bot with --replay <recording> --profile <tmp> (see
+// hlt/phase_profile.hpp) plus any flags after "--", which must be the ones the
+// game was recorded with. Its commands go to /dev/null. The bot is a separate
+// process, so a rep pays for startup and thread pool creation like a real game
+// does, and the numbers are what the engine would see minus the pipe.
+//
+// Output is CSV on stdout, one row per (recording, turn, ships, phase) and one
+// "all" row per (recording, phase) over every turn. Times are in ms. --json
+// writes the same rows to FILE.
+//
+// A turn only makes the same decisions it made live if it did not run out of
+// time then, so keep to recordings of games that stayed well inside the budget.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <string>
+#include <sys/wait.h>
+#include <tuple>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+struct Sample {
+    int turn;
+    int ships;
+    string phase;
+    double ms;
+};
+
+static double percentile(vector<double> &v, double q) {
+    if (v.empty()) return 0;
+    size_t k = min(v.size() - 1, (size_t)(q * (v.size() - 1) + 0.5));
+    nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+// Runs the bot over one recording; false if it did not exit cleanly.
+static bool run_bot(const string &bot, const string &recording, const string &profile,
+                    const vector<string> &flags) {
+    vector<string> args = {bot, "--replay", recording, "--profile", profile};
+    args.insert(args.end(), flags.begin(), flags.end());
+    vector<char *> argv;
+    for (auto &a : args) {
+        argv.push_back(const_cast<char *>(a.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    pid_t pid = fork();
+    if (pid < 0) return false;
+    if (pid == 0) {
+        int null = open("/dev/null", O_RDWR);
+        if (null >= 0) {
+            dup2(null, 0);
+            dup2(null, 1);
+        }
+        execv(bot.c_str(), argv.data());
+        _exit(127);
+    }
+    int status;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) return false;
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+static bool read_profile(const string &path, vector<Sample> &out) {
+    FILE *f = fopen(path.c_str(), "r");
+    if (f == nullptr) return false;
+    char line[256];
+    // header
+    if (fgets(line, sizeof(line), f) == nullptr) {
+        fclose(f);
+        return false;
+    }
+    char phase[64];
+    Sample s;
+    while (fgets(line, sizeof(line), f) != nullptr) {
+        if (sscanf(line, "%d,%d,%63[^,],%lf", &s.turn, &s.ships, phase, &s.ms) == 4) {
+            s.phase = phase;
+            out.push_back(s);
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    int reps = 5;
+    string bot = "./MyBot";
+    string json_path;
+    vector<string> files;
+    vector<string> flags;
+    for (int i = 1; i < argc; i++) {
+        if (string(argv[i]) == "--reps" && i + 1 < argc) {
+            reps = max(1, atoi(argv[++i]));
+        }
+        else if (string(argv[i]) == "--bot" && i + 1 < argc) {
+            bot = argv[++i];
+        }
+        else if (string(argv[i]) == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        }
+        else if (string(argv[i]) == "--") {
+            flags.assign(argv + i + 1, argv + argc);
+            break;
+        }
+        else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.empty()) {
+        fprintf(stderr, "usage: %s [--reps N] [--bot PATH] [--json FILE] recordings... [-- bot flags]\n", argv[0]);
+        return 1;
+    }
+
+    char profile[] = "/tmp/turn_bench.XXXXXX";
+    int fd = mkstemp(profile);
+    if (fd < 0) {
+        fprintf(stderr, "could not create a profile file\n");
+        return 1;
+    }
+    close(fd);
+
+    // (recording, turn, ships, phase) -> ms, turn -1 for the "all" rows
+    map<tuple<int, int, int, string>, vector<double>> stats;
+    vector<Sample> samples;
+    for (int f = 0; f < (int)files.size(); f++) {
+        for (int rep = 0; rep < reps; rep++) {
+            samples.clear();
+            if (!run_bot(bot, files[f], profile, flags) || !read_profile(profile, samples)) {
+                fprintf(stderr, "replay of %s failed (rep %d)\n", files[f].c_str(), rep);
+                unlink(profile);
+                return 1;
+            }
+            for (auto &s : samples) {
+                stats[make_tuple(f, s.turn, s.ships, s.phase)].push_back(s.ms);
+                stats[make_tuple(f, -1, -1, s.phase)].push_back(s.ms);
+            }
+        }
+    }
+    unlink(profile);
+
+    FILE *json = nullptr;
+    if (!json_path.empty()) {
+        json = fopen(json_path.c_str(), "w");
+        if (json == nullptr) {
+            fprintf(stderr, "could not open %s\n", json_path.c_str());
+            return 1;
+        }
+        fprintf(json, "[");
+    }
+
+    printf("recording,turn,ships,phase,samples,p50_ms,p95_ms,p99_ms\n");
+    bool first = true;
+    for (auto &entry : stats) {
+        const string &file = files[get<0>(entry.first)];
+        int turn = get<1>(entry.first);
+        int ships = get<2>(entry.first);
+        const string &phase = get<3>(entry.first);
+        vector<double> &ms = entry.second;
+        double p50 = percentile(ms, 0.5), p95 = percentile(ms, 0.95), p99 = percentile(ms, 0.99);
+
+        string turn_s = turn < 0 ? "all" : to_string(turn);
+        string ships_s = ships < 0 ? "all" : to_string(ships);
+        printf("%s,%s,%s,%s,%d,%.4f,%.4f,%.4f\n", file.c_str(), turn_s.c_str(), ships_s.c_str(), phase.c_str(),
+               (int)ms.size(), p50, p95, p99);
+        if (json != nullptr) {
+            fprintf(json, "%s\n {\"recording\": \"%s\", \"turn\": %s, \"ships\": %s, \"phase\": \"%s\", "
+                          "\"samples\": %d, \"p50_ms\": %.4f, \"p95_ms\": %.4f, \"p99_ms\": %.4f}",
+                    first ? "" : ",", file.c_str(), turn < 0 ? "null" : turn_s.c_str(),
+                    ships < 0 ? "null" : ships_s.c_str(), phase.c_str(), (int)ms.size(), p50, p95, p99);
+        }
+        first = false;
+    }
+    if (json != nullptr) {
+        fprintf(json, "\n]\n");
+        fclose(json);
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "assignment_dump.hpp"
+
+#include <cstring>
+
+using namespace hlt;
+
+static const char MAGIC[4] = {'H', 'A', 'S', 'M'};
+static const int VERSION = 1;
+
+void AssignmentRecord::clear(int kind, int turn, int cols) {
+    this->kind = kind;
+    this->turn = turn;
+    this->cols = cols;
+    row_key.clear();
+    row_start.assign(1, 0);
+    edge_col.clear();
+    edge_cost.clear();
+}
+
+void AssignmentRecord::add_edge(int col, double cost) {
+    edge_col.push_back(col);
+    edge_cost.push_back(cost);
+}
+
+void AssignmentRecord::end_row(int key) {
+    row_key.push_back(key);
+    row_start.push_back((int)edge_col.size());
+}
+
+AssignmentDump::~AssignmentDump() {
+    if (file != nullptr) {
+        fclose(file);
+    }
+}
+
+bool AssignmentDump::open(const string &path) {
+    file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    fwrite(MAGIC, 1, 4, file);
+    fwrite(&VERSION, sizeof(int), 1, file);
+    return true;
+}
+
+void AssignmentDump::write(const AssignmentRecord &record) {
+    if (file == nullptr) return;
+
+    int header[5] = {record.kind, record.turn, record.rows(), record.cols, (int)record.edge_col.size()};
+    fwrite(header, sizeof(int), 5, file);
+    fwrite(record.row_key.data(), sizeof(int), record.row_key.size(), file);
+    fwrite(record.row_start.data(), sizeof(int), record.row_start.size(), file);
+    fwrite(record.edge_col.data(), sizeof(int), record.edge_col.size(), file);
+    fwrite(record.edge_cost.data(), sizeof(double), record.edge_cost.size(), file);
+    // a bot can be killed mid game, keep what we have on disk
+    fflush(file);
+}
+
+template<typename T>
+static bool read_array(FILE *in, vector<T> &out, int n) {
+    out.resize(n);
+    return n == 0 || (int)fread(out.data(), sizeof(T), n, in) == n;
+}
+
+bool AssignmentDump::read(const string &path, vector<AssignmentRecord> &records) {
+    FILE *in = fopen(path.c_str(), "rb");
+    if (in == nullptr) {
+        return false;
+    }
+
+    char magic[4];
+    int version = 0;
+    bool ok = fread(magic, 1, 4, in) == 4 && memcmp(magic, MAGIC, 4) == 0
+              && fread(&version, sizeof(int), 1, in) == 1 && version == VERSION;
+
+    int header[5];
+    while (ok && fread(header, sizeof(int), 5, in) == 5) {
+        int rows = header[2];
+        int edges = header[4];
+        if (rows < 0 || edges < 0) {
+            ok = false;
+            break;
+        }
+
+        AssignmentRecord record;
+        record.kind = header[0];
+        record.turn = header[1];
+        record.cols = header[3];
+        ok = read_array(in, record.row_key, rows)
+             && read_array(in, record.row_start, rows + 1)
+             && read_array(in, record.edge_col, edges)
+             && read_array(in, record.edge_cost, edges)
+             && record.row_start.back() == edges;
+        if (ok) {
+            records.push_back(std::move(record));
+        }
+    }
+
+    fclose(in);
+    return ok;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace std;
+namespace hlt {
+
+    // Recorded assignment problems for offline benchmarking. A file is a small
+    // header followed by records; every record is one solve from one turn:
+    //
+    //   header: "HASM" int32 version
+    //   record: int32 kind, int32 turn, int32 rows, int32 cols, int32 edges
+    //           int32 row_key[rows]       (ship ids)
+    //           int32 row_start[rows + 1]
+    //           int32 edge_col[edges]     (cell index y * width + x)
+    //           double edge_cost[edges]
+    //
+    // Gather rows keep repeated columns, they are the collision target slots.
+    // All integers are little endian, as written by the bot.
+    struct AssignmentRecord {
+        enum Kind {
+            GATHER = 0,
+            RESOLVE = 1,
+        };
+
+        int kind = GATHER;
+        int turn = 0;
+        int cols = 0;
+        vector<int> row_key;
+        vector<int> row_start = vector<int>(1, 0);
+        vector<int> edge_col;
+        vector<double> edge_cost;
+
+        int rows() const {
+            return (int)row_key.size();
+        }
+
+        void clear(int kind, int turn, int cols);
+        void add_edge(int col, double cost);
+        void end_row(int key);
+    };
+
+    class AssignmentDump {
+    public:
+        ~AssignmentDump();
+
+        bool open(const string &path);
+
+        bool is_open() const {
+            return file != nullptr;
+        }
+
+        void write(const AssignmentRecord &record);
+
+        // Appends every record in path; false if the file is missing or malformed.
+        static bool read(const string &path, vector<AssignmentRecord> &records);
+
+    private:
+        FILE *file = nullptr;
+    };
+}
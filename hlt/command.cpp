@@ -1,19 +1,69 @@
 #include "command.hpp"
 
-#include <iostream>
+#include <cerrno>
+#include <unistd.h>
 
-constexpr char GENERATE= 'g';
-constexpr char CONSTRUCT[] = "c ";
-constexpr char MOVE[] = "m ";
+constexpr char GENERATE = 'g';
+constexpr char CONSTRUCT = 'c';
+constexpr char MOVE = 'm';
 
 hlt::Command hlt::command::spawn_ship() {
-    return std::string(1, GENERATE);
+    return Command{GENERATE, 0, Direction::STILL};
 }
 
 hlt::Command hlt::command::transform_ship_into_dropoff_site(EntityId id) {
-    return CONSTRUCT + std::to_string(id);
+    return Command{CONSTRUCT, id, Direction::STILL};
 }
 
 hlt::Command hlt::command::move(EntityId id, hlt::Direction direction) {
-    return MOVE + std::to_string(id) + ' ' + static_cast<char>(direction);
+    return Command{MOVE, id, direction};
+}
+
+char *hlt::CommandBuffer::put_int(char *out, int value) {
+    if (value < 0) {
+        *out++ = '-';
+        value = -value;
+    }
+    char digits[10];
+    int n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (n > 0) *out++ = digits[--n];
+    return out;
+}
+
+bool hlt::CommandBuffer::send(const std::vector<Command> &commands) {
+    size_t needed = commands.size() * MAX_COMMAND + 1;
+    if (buffer.size() < needed) {
+        buffer.resize(needed);
+    }
+
+    // same text as before: every command followed by a space, then a newline
+    char *out = buffer.data();
+    for (const auto &c : commands) {
+        *out++ = c.type;
+        *out++ = ' ';
+        if (c.type != GENERATE) {
+            out = put_int(out, c.id);
+            *out++ = ' ';
+        }
+        if (c.type == MOVE) {
+            *out++ = static_cast<char>(c.direction);
+            *out++ = ' ';
+        }
+    }
+    *out++ = '\n';
+
+    const char *pos = buffer.data();
+    while (pos < out) {
+        ssize_t n = write(1, pos, out - pos);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        pos += n;
+    }
+    return true;
 }
@@ -3,14 +3,37 @@
 #include "direction.hpp"
 #include "types.hpp"
 
-#include <string>
+#include <cstddef>
+#include <vector>
 
 namespace hlt {
-    typedef std::string Command;
+    // One engine command as plain fields; the text only exists once the whole
+    // turn is serialized by CommandBuffer.
+    struct Command {
+        char type;
+        EntityId id;
+        Direction direction;
+    };
 
     namespace command {
         Command spawn_ship();
         Command transform_ship_into_dropoff_site(EntityId id);
         Command move(EntityId id, Direction direction);
     }
+
+    // Serializes a turn's commands into one reused buffer and hands it to the
+    // engine with a single write(2) (more only if the pipe takes it in parts).
+    class CommandBuffer {
+    public:
+        // False once the engine has gone away.
+        bool send(const std::vector<Command> &commands);
+
+    private:
+        // "m <id> <dir> " is the longest command
+        static const int MAX_COMMAND = 16;
+
+        char *put_int(char *out, int value);
+
+        std::vector<char> buffer;
+    };
 }
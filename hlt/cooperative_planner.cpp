@@ -0,0 +1,226 @@
+#include "cooperative_planner.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+using namespace hlt;
+
+constexpr double CooperativePlanner::BANNED;
+constexpr double CooperativePlanner::SOFT_WEIGHT;
+
+void CooperativePlanner::resize(int width, int height) {
+    this->width = width;
+    this->height = height;
+    cells = width * height;
+    hard.resize(cells);
+    soft.resize(cells);
+
+    int states = (WINDOW + 1) * cells;
+    stamp.assign(states, 0);
+    mask.assign(states, 0);
+    hits.assign(states, array<uint8_t, 5>());
+    parent.assign(states, array<int, 5>());
+}
+
+void CooperativePlanner::begin_turn(int turn) {
+    this->turn = turn;
+    swap(hard, soft);
+    soft.advance();
+    hard.clear();
+    last_plans.swap(plans);
+    plans.clear();
+    agents.clear();
+}
+
+int CooperativePlanner::add_agent(EntityId id, Position start, Position dest, const array<double, 5> &costs,
+                                  double delay_cost, int rank, bool holds_dest) {
+    Agent agent;
+    agent.id = id;
+    agent.start = start.y * width + start.x;
+    agent.dest = dest.y * width + dest.x;
+    agent.costs = costs;
+    agent.delay_cost = delay_cost;
+    agent.rank = rank;
+    agent.holds_dest = holds_dest;
+    agent.key = 0;
+    agents.push_back(agent);
+    return (int)agents.size() - 1;
+}
+
+// ALL_DIRS order: still, north, south, east, west
+int CooperativePlanner::step(int cell, int k) const {
+    int x = cell % width;
+    int y = cell / width;
+    switch (k) {
+        case 1: y = y == 0 ? height - 1 : y - 1; break;
+        case 2: y = y == height - 1 ? 0 : y + 1; break;
+        case 3: x = x == width - 1 ? 0 : x + 1; break;
+        case 4: x = x == 0 ? width - 1 : x - 1; break;
+        default: break;
+    }
+    return y * width + x;
+}
+
+int CooperativePlanner::distance(int a, int b) const {
+    int dx = abs(a % width - b % width);
+    int dy = abs(a / width - b / width);
+    return min(dx, width - dx) + min(dy, height - dy);
+}
+
+void CooperativePlanner::plan() {
+    bool reprioritize = turn % REPRIORITIZE_EVERY == 0;
+    unordered_map<EntityId, double> next_keys;
+    for (auto &a : agents) {
+        auto it = keys.find(a.id);
+        if (reprioritize || it == keys.end()) {
+            // held up ships first, then the ones closest to where they are going
+            auto d = delayed.find(a.id);
+            a.key = distance(a.start, a.dest) - (d == delayed.end() ? 0 : (double)cells * d->second);
+        }
+        else {
+            a.key = it->second;
+        }
+        next_keys[a.id] = a.key;
+    }
+    keys.swap(next_keys);
+    delayed.clear();
+
+    vector<int> order(agents.size());
+    for (int i = 0; i < (int)order.size(); i++) order[i] = i;
+    sort(order.begin(), order.end(), [&](int a, int b) {
+        const Agent &x = agents[a];
+        const Agent &y = agents[b];
+        if (x.rank != y.rank) return x.rank < y.rank;
+        if (x.key != y.key) return x.key < y.key;
+        return x.id < y.id;
+    });
+
+    for (int i : order) {
+        search(agents[i]);
+    }
+}
+
+void CooperativePlanner::search(Agent &agent) {
+    serial++;
+    for (auto &f : frontier) f.clear();
+
+    auto own = last_plans.find(agent.id);
+    const vector<int> *old = own == last_plans.end() ? nullptr : &own->second;
+    auto soft_hit = [&](int t, int c) -> int {
+        if (!soft.reserved(t, c)) return 0;
+        // our own plan from last turn, one turn on
+        return old != nullptr && t + 1 < (int)old->size() && (*old)[t + 1] == c ? 0 : 1;
+    };
+    auto visit = [&](int t, int c) -> int {
+        int i = t * cells + c;
+        if (stamp[i] != serial) {
+            stamp[i] = serial;
+            mask[i] = 0;
+            frontier[t].push_back(c);
+        }
+        return i;
+    };
+
+    for (int k = 0; k < 5; k++) {
+        if (agent.costs[k] >= BANNED) continue;
+        int c = step(agent.start, k);
+        if (hard.reserved(1, c)) continue;
+        int i = visit(1, c);
+        mask[i] |= 1 << k;
+        hits[i][k] = (uint8_t)soft_hit(1, c);
+        parent[i][k] = agent.start;
+    }
+
+    const double inf = numeric_limits<double>::infinity();
+    array<double, 5> best;
+    array<int, 5> best_turn;
+    array<int, 5> best_cell;
+    best.fill(inf);
+
+    for (int t = 1; t <= WINDOW; t++) {
+        for (int c : frontier[t]) {
+            int i = t * cells + c;
+            int m = mask[i];
+            if (c == agent.dest || t == WINDOW) {
+                int estimate = c == agent.dest ? t : t + distance(c, agent.dest);
+                for (int b = 0; b < 5; b++) {
+                    if (!(m >> b & 1)) continue;
+                    double score = estimate + SOFT_WEIGHT * hits[i][b];
+                    if (score < best[b]) {
+                        best[b] = score;
+                        best_turn[b] = t;
+                        best_cell[b] = c;
+                    }
+                }
+                continue;
+            }
+            for (int k = 0; k < 5; k++) {
+                int nc = step(c, k);
+                if (hard.reserved(t + 1, nc)) continue;
+                int hit = soft_hit(t + 1, nc);
+                int j = visit(t + 1, nc);
+                for (int b = 0; b < 5; b++) {
+                    if (!(m >> b & 1)) continue;
+                    int h = hits[i][b] + hit;
+                    if (!(mask[j] >> b & 1) || h < hits[j][b]) {
+                        mask[j] |= 1 << b;
+                        hits[j][b] = (uint8_t)h;
+                        parent[j][b] = c;
+                    }
+                }
+            }
+        }
+    }
+
+    double lowest = inf;
+    for (int k = 0; k < 5; k++) lowest = min(lowest, best[k]);
+
+    // moves that cannot get anywhere in the window count as a full window late
+    if (lowest < inf) {
+        for (int k = 0; k < 5; k++) {
+            if (agent.costs[k] >= BANNED) continue;
+            double late = best[k] < inf ? best[k] - lowest : WINDOW;
+            agent.costs[k] += agent.delay_cost * late;
+        }
+    }
+    int k = 0;
+    for (int d = 1; d < 5; d++) {
+        if (agent.costs[d] < agent.costs[k]) k = d;
+    }
+    agent.chosen = k;
+
+    vector<int> &path = plans[agent.id];
+    if (best[k] < inf) {
+        delayed[agent.id] = (int)(best[k] - distance(agent.start, agent.dest));
+        path.assign(best_turn[k] + 1, agent.start);
+        int c = best_cell[k];
+        for (int t = best_turn[k]; t >= 1; t--) {
+            path[t] = c;
+            hard.reserve(t, c);
+            c = parent[t * cells + c][k];
+        }
+        // parked on dest for the rest of the window
+        if (agent.holds_dest && best_cell[k] == agent.dest) {
+            for (int t = best_turn[k] + 1; t <= WINDOW; t++) {
+                path.push_back(agent.dest);
+                hard.reserve(t, agent.dest);
+            }
+        }
+    }
+    else {
+        // boxed in, the resolver still needs somewhere to put it: the cheapest move
+        // nobody has claimed, staying put if every move is claimed
+        k = 0;
+        double k_cost = inf;
+        for (int d = 0; d < 5; d++) {
+            if (agent.costs[d] < k_cost && !hard.reserved(1, step(agent.start, d))) {
+                k = d;
+                k_cost = agent.costs[d];
+            }
+        }
+        agent.chosen = k;
+        path = {agent.start, step(agent.start, k)};
+        hard.reserve(1, path[1]);
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "types.hpp"
+#include "reservation_table.hpp"
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+namespace hlt {
+
+    // Windowed cooperative pathfinding (WHCA*). Ships are planned one after another
+    // through a shared space-time reservation table, WINDOW turns deep, and each
+    // plan reserves its cells for the ships planned after it. Past the window the
+    // toroidal distance stands in for the rest of the route.
+    //
+    // Each ship comes with its five move costs (ALL_DIRS order, BANNED or more
+    // means never). plan() adds delay_cost for every turn a first move loses
+    // against the best one under the reservations, and reserves the path of the
+    // cheapest move after that. Last turn's plans stay around as soft
+    // reservations that only break ties, so a ship keeps to a route it already
+    // shares with the others unless something better opens up.
+    //
+    // Plan order is by rank, then by a per-ship key that is refreshed every
+    // REPRIORITIZE_EVERY turns: ships the others held up the most go first.
+    class CooperativePlanner {
+    public:
+        static const int WINDOW = 8;
+        static const int REPRIORITIZE_EVERY = 4;
+        static constexpr double BANNED = 1e11;
+        // one soft hit is worth this many turns
+        static constexpr double SOFT_WEIGHT = 0.25;
+
+        void resize(int width, int height);
+
+        // Last turn's reservations become soft, the table starts empty.
+        void begin_turn(int turn);
+
+        // Returns the agent index. Lower ranks plan first. A ship that holds_dest
+        // keeps dest reserved from the turn it arrives to the end of the window.
+        int add_agent(EntityId id, Position start, Position dest, const array<double, 5> &costs,
+                      double delay_cost, int rank, bool holds_dest);
+
+        void plan();
+
+        double cost(int agent, int k) const {
+            return agents[agent].costs[k];
+        }
+
+        // ALL_DIRS index of the move whose path got reserved
+        int chosen(int agent) const {
+            return agents[agent].chosen;
+        }
+
+        int planned() const {
+            return (int)agents.size();
+        }
+
+    private:
+        struct Agent {
+            EntityId id;
+            int start;
+            int dest;
+            array<double, 5> costs;
+            double delay_cost;
+            int rank;
+            bool holds_dest;
+            double key;
+            int chosen = 0;
+        };
+
+        int step(int cell, int k) const;
+        int distance(int a, int b) const;
+
+        void search(Agent &agent);
+
+        int width = 0;
+        int height = 0;
+        int cells = 0;
+        int turn = 0;
+
+        ReservationTable hard;
+        ReservationTable soft;
+
+        vector<Agent> agents;
+        // cells of each ship's reserved path, index 0 is the turn it was planned on
+        unordered_map<EntityId, vector<int>> plans;
+        unordered_map<EntityId, vector<int>> last_plans;
+        // how many turns each ship lost to the others last time it was planned
+        unordered_map<EntityId, int> delayed;
+        unordered_map<EntityId, double> keys;
+
+        // search scratch, (turn, cell) states stamped per agent
+        vector<uint32_t> stamp;
+        vector<uint8_t> mask;
+        vector<array<uint8_t, 5>> hits;
+        vector<array<int, 5>> parent;
+        vector<int> frontier[WINDOW + 1];
+        uint32_t serial = 0;
+    };
+}
@@ -0,0 +1,147 @@
+#include "direction_resolver.hpp"
+
+#include <algorithm>
+
+using namespace hlt;
+
+void DirectionResolver::clear() {
+    ship_options.clear();
+    chosen.clear();
+    cell_pos.clear();
+    cell_index.clear();
+    cell_owner.clear();
+    parent.clear();
+    component_start.clear();
+    component_rows.clear();
+}
+
+int DirectionResolver::find(int a) {
+    while (parent[a] != a) {
+        parent[a] = parent[parent[a]];
+        a = parent[a];
+    }
+    return a;
+}
+
+int DirectionResolver::add_ship(const array<pair<Position, double>, 5> &options) {
+    int row = (int)ship_options.size();
+    ship_options.emplace_back();
+    parent.push_back(row);
+    chosen.push_back(-1);
+
+    for (int d = 0; d < 5; d++) {
+        auto it = cell_index.find(options[d].first);
+        int cell;
+        if (it == cell_index.end()) {
+            cell = (int)cell_pos.size();
+            cell_index[options[d].first] = cell;
+            cell_pos.push_back(options[d].first);
+            cell_owner.push_back(row);
+        }
+        else {
+            cell = it->second;
+            // a shared cell puts both ships in the same component
+            int a = find(cell_owner[cell]);
+            int b = find(row);
+            if (a != b) parent[a] = b;
+        }
+        ship_options[row][d] = {cell, options[d].second};
+    }
+    return row;
+}
+
+void DirectionResolver::build_components() {
+    int n = (int)ship_options.size();
+
+    // counting sort of ships by component root
+    vector<int> root_component(n, -1);
+    vector<int> sizes;
+    for (int r = 0; r < n; r++) {
+        int root = find(r);
+        if (root_component[root] == -1) {
+            root_component[root] = (int)sizes.size();
+            sizes.push_back(0);
+        }
+        sizes[root_component[root]]++;
+    }
+
+    component_start.assign(sizes.size() + 1, 0);
+    for (int c = 0; c < (int)sizes.size(); c++) {
+        component_start[c + 1] = component_start[c] + sizes[c];
+    }
+    component_rows.assign(n, 0);
+    vector<int> fill(component_start.begin(), component_start.end() - 1);
+    for (int r = 0; r < n; r++) {
+        component_rows[fill[root_component[find(r)]]++] = r;
+    }
+}
+
+void DirectionResolver::enumerate(int depth, double cost, double &best, const int *rows, int k, Scratch &scratch) {
+    if (cost >= best) return;
+    if (depth == k) {
+        best = cost;
+        scratch.best_choice.assign(scratch.choice.begin(), scratch.choice.begin() + k);
+        return;
+    }
+    auto &options = ship_options[rows[depth]];
+    for (int d = 0; d < 5; d++) {
+        int cell = options[d].first;
+        if (scratch.used[cell]) continue;
+        scratch.used[cell] = 1;
+        scratch.choice[depth] = cell;
+        enumerate(depth + 1, cost + options[d].second, best, rows, k, scratch);
+        scratch.used[cell] = 0;
+    }
+}
+
+void DirectionResolver::solve_component(int c, Scratch &scratch) {
+    const int *rows = &component_rows[component_start[c]];
+    int k = component_start[c + 1] - component_start[c];
+
+    if ((int)scratch.used.size() < (int)cell_pos.size()) {
+        scratch.used.resize(cell_pos.size(), 0);
+        scratch.local_index.resize(cell_pos.size(), -1);
+    }
+
+    if (k <= ENUMERATION_LIMIT) {
+        double best = 1e300;
+        scratch.choice.resize(k);
+        enumerate(0, 0, best, rows, k, scratch);
+        for (int i = 0; i < k; i++) {
+            chosen[rows[i]] = scratch.best_choice[i];
+        }
+        return;
+    }
+
+    // Local k x m hungarian over just this component's cells.
+    auto &local_cells = scratch.local_cells;
+    local_cells.clear();
+    for (int i = 0; i < k; i++) {
+        for (auto &o : ship_options[rows[i]]) {
+            if (scratch.local_index[o.first] == -1) {
+                scratch.local_index[o.first] = (int)local_cells.size();
+                local_cells.push_back(o.first);
+            }
+        }
+    }
+    int m = (int)local_cells.size();
+    scratch.costs.assign(k * m, 1e30);
+    for (int i = 0; i < k; i++) {
+        for (auto &o : ship_options[rows[i]]) {
+            scratch.costs[i * m + scratch.local_index[o.first]] = o.second;
+        }
+    }
+    scratch.hungarian.Solve(scratch.costs.data(), k, m, m, scratch.assignment, scratch.workspace);
+    for (int i = 0; i < k; i++) {
+        chosen[rows[i]] = local_cells[scratch.assignment[i]];
+    }
+    for (int cell : local_cells) {
+        scratch.local_index[cell] = -1;
+    }
+}
+
+void DirectionResolver::solve() {
+    for (int c = 0; c < components(); c++) {
+        solve_component(c, scratch);
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "types.hpp"
+#include "position.hpp"
+#include "hungarian.hpp"
+
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+
+using namespace std;
+namespace hlt {
+
+    // One turn lookahead move resolution. Every ship picks one of its five
+    // neighbouring cells and no two ships may pick the same cell. Ships only
+    // interact through shared cells, so the ship/cell graph splits into small
+    // connected components that are solved exactly and independently: by
+    // enumeration when tiny, with a local hungarian otherwise.
+    class DirectionResolver {
+    public:
+        // Per solver scratch. Components touch nothing else, so distinct
+        // components can be solved concurrently with one Scratch each.
+        struct Scratch {
+            HungarianAlgorithm hungarian;
+            HungarianWorkspace workspace;
+            vector<double> costs;
+            vector<int> assignment;
+            vector<int> local_index;
+            vector<int> local_cells;
+            vector<int> choice;
+            vector<int> best_choice;
+            vector<char> used;
+        };
+
+        void clear();
+
+        // Returns the ship's row. options are the (cell, cost) pairs it may move to.
+        int add_ship(const array<pair<Position, double>, 5> &options);
+
+        // Splits the ships added so far into independent components.
+        void build_components();
+
+        int components() const {
+            return (int)component_start.size() - 1;
+        }
+
+        void solve_component(int c, Scratch &scratch);
+
+        // Solves every component in turn.
+        void solve();
+
+        Position result(int row) const {
+            return cell_pos[chosen[row]];
+        }
+
+    private:
+        static const int ENUMERATION_LIMIT = 5;
+
+        int find(int a);
+
+        void enumerate(int depth, double cost, double &best, const int *rows, int k, Scratch &scratch);
+
+        // ship rows: five (cell, cost) options each
+        vector<array<pair<int, double>, 5>> ship_options;
+        vector<int> chosen;
+
+        vector<Position> cell_pos;
+        unordered_map<Position, int> cell_index;
+        vector<int> cell_owner;
+
+        // union find over ships, then ships grouped by component
+        vector<int> parent;
+        vector<int> component_start;
+        vector<int> component_rows;
+
+        Scratch scratch;
+    };
+}
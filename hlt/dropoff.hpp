@@ -9,7 +9,5 @@ namespace hlt {
         using Entity::Entity;
 
         bool is_fake = false;
-
-        static std::shared_ptr<Dropoff> _generate(PlayerId player_id);
     };
 }
@@ -8,6 +8,8 @@ namespace hlt {
         PlayerId owner;
         EntityId id;
         Position position;
+        // Player::frame_mark of the last frame that listed it
+        int seen = 0;
 
         Entity(PlayerId owner, EntityId id, int x, int y) :
             owner(owner),
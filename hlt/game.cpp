@@ -1,16 +1,16 @@
 #include "game.hpp"
 #include "input.hpp"
-
-#include <sstream>
+#include "mining.hpp"
+#include "utils.hpp"
 
 hlt::Game::Game() : turn_number(0) {
     std::ios_base::sync_with_stdio(false);
 
     hlt::constants::populate_constants(hlt::get_string());
+    hlt::mining::build_tables();
 
-    int num_players;
-    std::stringstream input(get_string());
-    input >> num_players >> my_id;
+    int num_players = get_int();
+    my_id = get_int();
 
     log::open(my_id);
 
@@ -18,7 +18,12 @@ hlt::Game::Game() : turn_number(0) {
         players.push_back(Player::_generate());
     }
     me = players[my_id];
+
+    Timer load;
+    load.start();
     game_map = GameMap::_generate();
+    log::log("Map " + std::to_string(game_map->width) + "x" + std::to_string(game_map->height) + " parsed in ms",
+             load.elapsed() * 1000);
 }
 
 void hlt::Game::ready(const std::string& name) {
@@ -26,15 +31,14 @@ void hlt::Game::ready(const std::string& name) {
 }
 
 void hlt::Game::update_frame() {
-    hlt::get_sstream() >> turn_number;
+    turn_number = hlt::get_int();
     log::log("=============== TURN " + std::to_string(turn_number) + " ================");
 
     for (size_t i = 0; i < players.size(); ++i) {
-        PlayerId current_player_id;
-        int num_ships;
-        int num_dropoffs;
-        Halite halite;
-        hlt::get_sstream() >> current_player_id >> num_ships >> num_dropoffs >> halite;
+        PlayerId current_player_id = hlt::get_int();
+        int num_ships = hlt::get_int();
+        int num_dropoffs = hlt::get_int();
+        Halite halite = hlt::get_int();
 
         players[current_player_id]->_update(num_ships, num_dropoffs, halite);
     }
@@ -57,9 +61,5 @@ void hlt::Game::update_frame() {
 }
 
 bool hlt::Game::end_turn(const std::vector<hlt::Command>& commands) {
-    for (const auto& command : commands) {
-        std::cout << command << ' ';
-    }
-    std::cout << std::endl;
-    return std::cout.good();
+    return command_buffer.send(commands);
 }
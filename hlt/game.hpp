@@ -3,6 +3,7 @@
 #include "game_map.hpp"
 #include "player.hpp"
 #include "types.hpp"
+#include "command.hpp"
 
 #include <vector>
 #include <iostream>
@@ -17,6 +18,7 @@ namespace hlt {
         std::vector<std::shared_ptr<Player>> players;
         std::shared_ptr<Player> me;
         std::unique_ptr<GameMap> game_map;
+        CommandBuffer command_buffer;
 
         std::vector<std::shared_ptr<Player>> getEnemies() {
             std::vector<std::shared_ptr<Player>> enemies;
@@ -1,6 +1,8 @@
 #include "game_map.hpp"
 #include "input.hpp"
 #include "game.hpp"
+#include "gather_planner.hpp"
+#include "mining.hpp"
 #include "utils.hpp"
 #include "metrics.hpp"
 #include <memory>
@@ -93,10 +95,8 @@ Ship* GameMap::closestFriendlyShip(hlt::Position pos) {
 
 
 void hlt::GameMap::_update() {
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            cells[y][x].ship.reset();
-        }
+    for (auto &cell : cells) {
+        cell.ship.reset();
     }
 
     avgAroundPointMemo.clear();
@@ -108,21 +108,22 @@ void hlt::GameMap::_update() {
 
     closestEnemyDropMp.clear();
     closestDropMp.clear();
-    hal_mp.clear();
+    hal_plan.reset();
     planned_route.clear();
     set_route.clear();
     inspiredMemo.clear();
     inspiredCountMemo.clear();
+    rollout_grid.halite.clear();
+    rollout_cache.next_turn();
+    ship_plans.next_turn();
 
-    int update_count;
-    hlt::get_sstream() >> update_count;
+    int update_count = hlt::get_int();
 
     for (int i = 0; i < update_count; ++i) {
-        int x;
-        int y;
-        int halite;
-        hlt::get_sstream() >> x >> y >> halite;
-        cells[y][x].halite = halite;
+        int x = hlt::get_int();
+        int y = hlt::get_int();
+        int halite = hlt::get_int();
+        cells[y * width + x].halite = halite;
     }
 
 
@@ -140,39 +141,42 @@ void hlt::GameMap::_update() {
 std::unique_ptr<hlt::GameMap> hlt::GameMap::_generate() {
     std::unique_ptr<hlt::GameMap> map = std::make_unique<GameMap>();
 
-    hlt::get_sstream() >> map->width >> map->height;
+    map->width = hlt::get_int();
+    map->height = hlt::get_int();
 
-    map->cells.resize((size_t)map->height);
+    // rows come in the same order as the flat grid, so one pass fills it
+    map->cells.reserve((size_t)map->width * map->height);
     for (int y = 0; y < map->height; ++y) {
-        auto in = hlt::get_sstream();
-
-        map->cells[y].reserve((size_t)map->width);
         for (int x = 0; x < map->width; ++x) {
-            hlt::Halite halite;
-            in >> halite;
-
-            map->cells[y].push_back(MapCell(x, y, halite));
+            map->cells.emplace_back(x, y, hlt::get_int());
         }
     }
+    map->planned_route.resize(map->width * map->height);
+    map->set_route.resize(map->width * map->height);
+    map->hal_plan.resize(map->width * map->height);
 
     return map;
 }
 
 bool GameMap::checkSet(int future_turns, Position p) {
-    return set_route.count(TimePos{future_turns, p});
+    p = normalize(p);
+    return set_route.reserved(future_turns, p.y * width + p.x);
 }
 
 void GameMap::addSet(int future_turns, Position p, Ship *s) {
-    set_route[TimePos{future_turns, p}] = s;
+    p = normalize(p);
+    set_route.reserve(future_turns, p.y * width + p.x, s);
     addPlanned(1, p);
 }
 
 Ship* GameMap::getSet(int turns, Position p) {
-    return set_route[TimePos{turns, p}];
+    p = normalize(p);
+    return set_route.ship(turns, p.y * width + p.x);
 }
 
 bool GameMap::checkIfPlanned(int future_turns, Position p) {
-    return planned_route.count(TimePos{future_turns, p});
+    p = normalize(p);
+    return planned_route.reserved(future_turns, p.y * width + p.x);
 }
 
 void GameMap::clearPlanned() {
@@ -181,7 +185,7 @@ void GameMap::clearPlanned() {
 
 void GameMap::addPlanned(int future_turns, VC<Position> p) {
     for (int i = 0; i<(int)p.size(); i++) {
-        planned_route.insert(TimePos{i, p[i]});
+        addPlanned(i, p[i]);
     }
     for (int i = 0; i<(int)p.size() - 1; i++) {
         if (p[i] == p[i + 1]) {
@@ -191,7 +195,8 @@ void GameMap::addPlanned(int future_turns, VC<Position> p) {
 }
 
 void GameMap::addPlanned(int future_turns, Position p) {
-    planned_route.insert(TimePos{future_turns, p});
+    p = normalize(p);
+    planned_route.reserve(future_turns, p.y * width + p.x);
 }
 
 int GameMap::hal_at(Position p, int turn) {
@@ -199,24 +204,20 @@ int GameMap::hal_at(Position p, int turn) {
         return at(p)->halite;
     }
 
-    if (!hal_mp.count(p)) {
-        hal_mp[p] = std::set<int>();
-    }
-    int uses = distance(hal_mp[p].begin(), hal_mp[p].lower_bound(turn));
-    return at(p)->halite * pow(0.75, uses);
+    p = normalize(p);
+    int uses = hal_plan.uses(p.y * width + p.x, turn);
+    return mining::remaining(at(p)->halite, uses);
 }
 
 void GameMap::mine_hal(Position p, int turn) {
-    if (!hal_mp.count(p)) {
-        hal_mp[p] = std::set<int>();
-    }
-    hal_mp[p].insert(turn);
+    p = normalize(p);
+    hal_plan.mine(p.y * width + p.x, turn);
 }
 
 
 MapCell* GameMap::at(const Position& position) {
     Position normalized = normalize(position);
-    return &cells[normalized.y][normalized.x];
+    return &cells[normalized.y * width + normalized.x];
 }
 
 
@@ -260,181 +261,132 @@ Direction GameMap::getDirectDiff(Position a, Position b) {
     return Direction::STILL;
 }
 
-RandomWalkResult GameMap::get_best_random_walk(int starting_halite, Position start, Position dest, Order& order, double time_bank) {
+RandomWalkResult GameMap::get_best_random_walk(int starting_halite, Position start, Position dest, Order& order, Rng &rng, double time_bank) {
     Direction best_move = Direction::STILL;
     double best_cost = -1000000;
     int best_turns = 1;
     if (calculate_distance(start,dest) == 0) {
         order.add_dir_priority(Direction::STILL, 1);
-        return {Direction::STILL, (double)at(dest)->halite * 0.25, 1};
+        return {Direction::STILL, (double)mining::extract(at(dest)->halite), 1};
+    }
+    if (rollout_grid.empty()) {
+        prepare_rollouts();
     }
 
-    auto closest_enemy = closestEnemyShip(dest);
-    int turns_to_enemy = calculate_distance(closest_enemy->position, dest);
-
-    vector<Position> best_path;
     Timer timer;
     timer.start();
     int itrs = min(5000, (int)pow(calculate_distance(start, dest), 3) * 100);
-    int i = 0;
 
-    map<Direction, double> costMp;
     if (time_bank == -1) {
         itrs = 50;
         time_bank = 0;
     }
 
-    while (i < itrs + 1) {
-        if (time_bank != 0 && timer.elapsed() > time_bank) {
-            log::log("breaking cause time bank");
-            log::log(timer.elapsed(), time_bank);
-            break;
-        }
-        i++;
-
-        int curr_halite = starting_halite;
-        double turns = 1;
-
-        auto curr = start;
-        Direction first_move = Direction::STILL;
-
-        int cost = 0;
-        int curr_square_hal = at(curr)->halite;
-        vector<Position> path;
-        bool did_break = false;
-        while (dest != curr) {
-            //int enemies = enemies_around_point(curr, 5);
-            //int friends = friends_around_point(curr, 5);
-
-            /*
-            if (is_inspired(curr, constants::PID)) {
-                if (game->players.size() == 2 && turns < 7) {
-                    curr_square_hal += curr_square_hal * (friends - enemies) / 4.0;
-                }
-                else if (game->players.size() == 4) {
-                    curr_square_hal += curr_square_hal * (friends) / 9.0;
-                }
-            }*/
-
-            path.push_back(curr);
-            auto move = get_random_dir_towards(curr, dest);
-
-            /*
-            if (at(curr)->occupied_by_not(constants::PID)) {
-                int enemy_hal = at(curr)->ship->halite;
-                if (should_collide(curr, order.ship)) {
-                    if (game->players.size() == 4) {
-                        curr_halite += enemy_hal / 2;
-                    }
-                    else {
-                        curr_halite += enemy_hal;
-                    }
-                }
-            }*/
-
-            if (curr_halite < curr_square_hal * 0.1 || move == Direction::STILL) {
-                move = Direction::STILL;
-                if ((is_inspired(curr, constants::PID) || likely_inspired(curr, turns))) {
-                    // log::log("is inspired");
-                    curr_halite += ceil(2 * curr_square_hal * 0.25);
-                }
-                curr_halite += ceil(curr_square_hal * 0.25);
-                curr_square_hal -= ceil(0.25 * curr_square_hal);
-            }
-            else {
-                curr_halite -= floor(curr_square_hal * 0.1);
-                curr = normalize(curr.directional_offset(move));
-                cost += floor(curr_square_hal * 0.1);
-                curr_square_hal = at(curr)->halite;
-            }
-            if (turns == 1) {
-                first_move = move;
-                if (!costMp.count(first_move)) costMp[first_move] = -10;
-            }
-            turns += 1;
-            if (curr_halite >= 900) {
-                did_break = true;
-                break;
-            }
-        }
-        if (at(curr)->occupied_by_not(constants::PID)) {
-            int enemy_hal = at(curr)->ship->halite;
-            if (game->players.size() == 4) {
-                curr_halite += enemy_hal;
-            }
-            else {
-                curr_halite += enemy_hal;
-            }
-        }
-        int dest_halite = at(dest)->halite * 0.25;
-        int remaining_hal = at(dest)->halite * 0.75;
-        turns++;
-        if (is_inspired(dest, constants::PID) || likely_inspired(dest, turns)) {
-            dest_halite *= 3;
-        }
-        if (did_break) {
-            turns--;
-            dest_halite = 0;
-        }
-
-        if (abs(turns - turns_to_enemy) <= 1) {
-        }
-
-        //auto drop = closest_dropoff(curr, game);
-        //int turns_back = calculate_distance(curr, drop);
-        //turns += turns_back;
-        double c = (dest_halite + curr_halite - starting_halite) / turns;
-
-        for (int i = 1; i<=6; i++) {
-            if (did_break) break;
-            dest_halite += 0.25 * remaining_hal;
-            if (is_inspired(dest, constants::PID) || likely_inspired(dest, turns + i)) {
-                dest_halite += 0.5 * remaining_hal;
-            }
-            remaining_hal *= 0.75;
-            c = fmax(c, (dest_halite + curr_halite - starting_halite) / (turns + i));
+    start = normalize(start);
+    dest = normalize(dest);
+    int start_cell = start.y * width + start.x;
+    int dest_cell = dest.y * width + dest.x;
+
+    // A ship still on the walk it picked earlier just takes the next step. The
+    // other moves keep the priorities the walk's own tally gave them.
+    EntityId id = order.ship != nullptr ? order.ship->id : -1;
+    ShipPlans::Step step;
+    if (id != -1 && ship_plans.follow(rollout_grid, id, start_cell, dest_cell, starting_halite, step)) {
+        best_move = getDirectDiff(start, Position(step.next_cell % width, step.next_cell / width));
+        for (int m = 0; m < RolloutTally::MOVES; m++) {
+            if (step.priority[m] > 0) order.add_dir_priority(RolloutTally::MOVE_DIRS[m], step.priority[m]);
         }
+        order.add_dir_priority(best_move, 100);
+        return {best_move, step.value, step.turns, step.path};
+    }
 
-        //log::log(i, calculate_distance(start, dest), curr_halite, turns, c, first_move);
-        if (!costMp.count(first_move)) costMp[first_move] = c;
-        costMp[first_move] = fmax(costMp[first_move], c);
-        if (c > best_cost) {
-            best_path = path;
-            best_cost = c;
-            best_move = first_move;
-            best_turns = turns;
+    // Small boxes are solved exactly, sampling is only for long trips. A result
+    // from an earlier turn whose box barely changed is reused as is if exact, or
+    // gets a small top-up batch if sampled.
+    RolloutTally tally(best_cost);
+    vector<Position> best_path;
+    RolloutCache::Entry cached;
+    bool hit = rollout_cache.lookup(rollout_grid, start_cell, dest_cell, starting_halite, cached);
+    bool exact = hit ? cached.exact : GatherPlanner::fits(rollout_grid, start_cell, dest_cell);
+    bool store = !hit;
+    Timer *bank = time_bank != 0 ? &timer : nullptr;
+    RolloutBatch batch;
+    if (hit) {
+        tally = cached.tally;
+        best_path = cached.path;
+        if (!exact) {
+            batch.run(rollout_grid, start_cell, dest_cell, starting_halite, min(itrs + 1, RolloutCache::TOP_UP_WALKS),
+                      rng, bank, time_bank, tally);
+            rollout_cache.refresh(start_cell, dest_cell, starting_halite, tally);
         }
     }
-
-    for (auto d : costMp) {
+    else if (exact) {
+        GatherPlanner planner;
+        planner.solve(rollout_grid, start_cell, dest_cell, starting_halite, tally, best_path);
+    }
+    else if (!batch.run_adaptive(rollout_grid, start_cell, dest_cell, starting_halite, itrs + 1, rng, bank,
+                                 time_bank, tally)) {
+        log::log("breaking cause time bank");
+        log::log(timer.elapsed(), time_bank);
+        // cut short, not worth keeping
+        store = false;
+    }
+    if (store) {
+        cached.exact = exact;
+        cached.tally = tally;
+        cached.path = best_path;
+        rollout_cache.store(rollout_grid, start_cell, dest_cell, starting_halite, cached);
+    }
+    if (tally.has_best) {
+        best_cost = tally.best_cost;
+        best_move = tally.best.first_move;
+        best_turns = tally.best_turns;
+    }
+
+    array<double, RolloutTally::MOVES> priority;
+    priority.fill(0);
+    for (int m = 0; m < RolloutTally::MOVES; m++) {
+        if (!tally.move_seen[m]) continue;
         if (best_cost == 0) best_cost = 1;
-        order.add_dir_priority(d.first, 100 * pow(1e4, 1.0 - ((double)d.second / (double)best_cost)));
+        priority[m] = 100 * pow(1e4, 1.0 - (tally.move_cost[m] / best_cost));
+        order.add_dir_priority(RolloutTally::MOVE_DIRS[m], priority[m]);
         //log::log("Walks", order.ship->id, d.first, d.second, 1.0 - ((double)d.second / (double)best_cost));
         //log::log("Best cost", best_cost);
     }
 
+    // only the winning walk's cells are needed, replay it from its seed
+    if (!exact && tally.has_best) {
+        Rng replay;
+        replay.set_state(tally.best.seed);
+        best_path.reserve(tally.best.turns - 1);
+        rollout_walk(rollout_grid, start_cell, dest_cell, starting_halite, replay, &best_path,
+                     &tally.best.first_move);
+    }
+    if (id != -1 && tally.has_best && !best_path.empty()) {
+        ship_plans.store(rollout_grid, id, dest_cell, starting_halite, best_path, tally.best.end_cell, best_cost,
+                         best_turns, priority);
+    }
+
     return {best_move, best_cost, best_turns, best_path};
 }
 
-Direction GameMap::get_random_dir_towards(Position start, Position end) {
-    auto moves = get_unsafe_moves(start, end);
-    if (moves.size() == 0) {
-        moves.push_back(moves[0]);
-        moves.push_back(Direction::STILL);
-        if (moves[0] == Direction::NORTH || moves[0] == Direction::SOUTH) {
-            moves.push_back(Direction::WEST);
-            moves.push_back(Direction::EAST);
-        }
-        else {
-            moves.push_back(Direction::NORTH);
-            moves.push_back(Direction::SOUTH);
-        }
+bool GameMap::has_cached_walk(int starting_halite, Position start, Position dest, EntityId id) {
+    if (rollout_grid.empty()) {
+        prepare_rollouts();
     }
-    moves.push_back(Direction::STILL);
-    //if (rand() % 10) {
-    //    return ALL_CARDINALS[rand() % 4];
-    //}
-    return moves[rand() % moves.size()];
+    start = normalize(start);
+    dest = normalize(dest);
+    int start_cell = start.y * width + start.x;
+    int dest_cell = dest.y * width + dest.x;
+    if (id != -1 && ship_plans.holds(rollout_grid, id, start_cell, dest_cell, starting_halite)) return true;
+    return rollout_cache.has(rollout_grid, start_cell, dest_cell, starting_halite);
+}
+
+Direction GameMap::get_random_dir_towards(Position start, Position end, Rng &rng) {
+    Direction moves[5];
+    int count = get_unsafe_moves(start, end, moves);
+    moves[count++] = Direction::STILL;
+    return moves[rng.below(count)];
 }
 
 
@@ -500,9 +452,12 @@ BFSR GameMap::BFS(Position source, bool collide, int starting_hal) {
     vector<vector<int>> dist(width,vector<int>(height, def));
     vector<vector<Position>> parent(width,vector<Position>(height, {-1, -1}));
     vector<vector<int>> turns(width, vector<int>(height, 1e9));
+    vector<vector<int>> depth(width, vector<int>(height, -1));
+    vector<vector<Direction>> first(width, vector<Direction>(height, Direction::STILL));
 
     dist[source.x][source.y] = 0;
     turns[source.x][source.y] = 1;
+    depth[source.x][source.y] = 0;
 
     vector<Position> frontier;
     vector<Position> next;
@@ -537,30 +492,26 @@ BFSR GameMap::BFS(Position source, bool collide, int starting_hal) {
                     parent[p.x][p.y] = f;
                 }
             }
-        }
-    }
-    return BFSR{dist, parent, turns};
-}
 
-vector<Position> GameMap::traceBackPath(VVP parents, Position start, Position dest) {
-    Position curr = dest;
-    VC<Position> path(1, dest);
-
-    while (curr != start) {
-        curr = parents[curr.x][curr.y];
-        path.push_back(curr);
-        if (curr == Position{-1, -1}) {
-            return VC<Position>{start, curr};
+            // parent is final now and was itself finished before p, so path
+            // length and first move carry over in O(1)
+            Position f = parent[p.x][p.y];
+            if (p != source && f != Position{-1, -1} && depth[f.x][f.y] >= 0) {
+                depth[p.x][p.y] = depth[f.x][f.y] + 1;
+                first[p.x][p.y] = f == source ? getDirectDiff(source, p) : first[f.x][f.y];
+            }
         }
     }
-    std::reverse(path.begin(), path.end());
+    return BFSR{dist, parent, turns, depth, first};
+}
 
-    return path;
+void GameMap::traceBackPath(PathView bfs, Position start, Position dest, vector<Position> &path) {
+    bfs.trace(start, dest, path);
 }
 
-void GameMap::random_walk(VC<Position> &walk, int length, int seed) {
+void GameMap::random_walk(VC<Position> &walk, int length, int seed, Rng &rng) {
     if (length <= 0) return;
-    auto next = walk.back().directional_offset(ALL_CARDINALS[(seed + rand() % 3) % 4]);
+    auto next = walk.back().directional_offset(ALL_CARDINALS[(seed + rng.below(3)) % 4]);
     bool found = true;
     int max_itr = 20;
     int i = 0;
@@ -574,10 +525,10 @@ void GameMap::random_walk(VC<Position> &walk, int length, int seed) {
         }
     }
     walk.push_back(normalize(next));
-    random_walk(walk, length - 1, seed);
+    random_walk(walk, length - 1, seed, rng);
 }
 
-VC<Position> GameMap::random_walk(int starting_halite, Position start, Position dest) {
+VC<Position> GameMap::random_walk(int starting_halite, Position start, Position dest, Rng &rng) {
     start = normalize(start);
     dest = normalize(dest);
     vector<Position> path;
@@ -587,9 +538,9 @@ VC<Position> GameMap::random_walk(int starting_halite, Position start, Position
     }
 
     auto moves = get_unsafe_moves(start, dest);
-    auto dir = moves[rand() % moves.size()];
+    auto dir = moves[rng.below(moves.size())];
 
-    auto p2 = random_walk(starting_halite, start.directional_offset(dir), dest);
+    auto p2 = random_walk(starting_halite, start.directional_offset(dir), dest, rng);
     path.insert(path.end(), p2.begin(), p2.end());
     return path;
 }
@@ -597,18 +548,21 @@ VC<Position> GameMap::random_walk(int starting_halite, Position start, Position
 VC<Position> GameMap::wait_adjust(int starting_halite, VC<Position> walk, int turn) {
     int curr_hal = starting_halite;
     VC<Position> adjusted;
+    // the stays only shape this walk; addPlanned mines the one that gets picked
+    hal_plan.fork();
     for (auto a : walk) {
-        while (hal_at(a,turn) >= get_mine_threshold() || curr_hal < 0.1 * hal_at(a, turn)) {
+        while (hal_at(a,turn) >= get_mine_threshold() || curr_hal < mining::move_cost(hal_at(a, turn))) {
             if (curr_hal > 900) break;
-            curr_hal += ceil(0.25 * hal_at(a, turn));
+            curr_hal += mining::extract(hal_at(a, turn));
             turn++;
             mine_hal(a, turn);
             adjusted.push_back(a);
         }
-        curr_hal -= 0.1 * hal_at(a, turn);
+        curr_hal -= mining::move_cost(hal_at(a, turn));
         adjusted.push_back(a);
         turn++;
     }
+    hal_plan.rollback();
     return adjusted;
 }
 
@@ -638,13 +592,13 @@ int GameMap::getPathCost(VC<Position> p) {
     return out;
 }
 
-vector<Position> GameMap::hc_plan_gather_path(int starting_halite, Position start, Position end, vector<Position> starting_path) {
+vector<Position> GameMap::hc_plan_gather_path(int starting_halite, Position start, Position end, vector<Position> starting_path, Rng &rng) {
     auto walks = VC<VC<Position>>();
     auto allowed_walks = VC<VC<Position>>();
     VC<Position> chosen_walk = starting_path;
     double mcost = getPathCost(starting_path) / (double)max(1, (int)starting_path.size());
     for (int i = 0; i<50; i++) {
-        vector<Position> walk = random_walk(starting_halite, start, end);
+        vector<Position> walk = random_walk(starting_halite, start, end, rng);
         walks.push_back(wait_adjust(starting_halite, walk, 0));
         // log::log(i, walk.size());
         double cost = getPathCost(walks[i]) / (double)max(1, (int)walk.size());
@@ -659,15 +613,15 @@ vector<Position> GameMap::hc_plan_gather_path(int starting_halite, Position star
     return chosen_walk;
 }
 
-vector<Position> GameMap::hc_plan_gather_path(int starting_halite, Position start, vector<Position> starting_path) {
+vector<Position> GameMap::hc_plan_gather_path(int starting_halite, Position start, vector<Position> starting_path, Rng &rng) {
     auto walks = VC<VC<Position>>();
     auto allowed_walks = VC<VC<Position>>();
     VC<Position> chosen_walk = starting_path;
     int mcost = getPathCost(starting_path);
     for (int i = 0; i<50; i++) {
         vector<Position> walk = {start};
-        int turns = rand() % 30 + 5;
-        random_walk(walk, turns, rand());
+        int turns = rng.below(30) + 5;
+        random_walk(walk, turns, rng.next() & 0x7fffffff, rng);
         walks.push_back(wait_adjust(starting_halite, walk, 0));
         double cost = getPathCost(walks[i]) / (double)turns;
         if (cost > mcost) {
@@ -680,14 +634,14 @@ vector<Position> GameMap::hc_plan_gather_path(int starting_halite, Position star
     return chosen_walk;
 }
 
-vector<Direction> GameMap::plan_gather_path(int starting_halite, Position start, Position dest) {
+vector<Direction> GameMap::plan_gather_path(int starting_halite, Position start, Position dest, Rng &rng) {
     // out of 10 random walks take the one that maximizes halite^2 and doesn't conflict
     auto walks = VC<VC<Position>>();
     auto allowed_walks = VC<VC<Position>>();
     VC<Position> chosen_walk;
     int mcost = -100;
     for (int i = 0; i<5000; i++) {
-        walks.push_back(wait_adjust(starting_halite, random_walk(starting_halite, start, dest), 0));
+        walks.push_back(wait_adjust(starting_halite, random_walk(starting_halite, start, dest, rng), 0));
         int cost = getPathCost(walks[i]);
 
         if (cost > mcost && !path_conflicts(starting_halite, walks[i])) {
@@ -702,10 +656,11 @@ vector<Direction> GameMap::plan_gather_path(int starting_halite, Position start,
     return dirsFrompath(chosen_walk);
 }
 
-vector<Direction> GameMap::plan_min_cost_route(VVP parents, int starting_halite, Position start, Position dest, int time) {
-    VC<Position> path = traceBackPath(parents, start, dest);
+vector<Direction> GameMap::plan_min_cost_route(PathView bfs, int starting_halite, Position start, Position dest, Rng &rng, int time) {
+    VC<Position> path;
+    traceBackPath(bfs, start, dest, path);
     if (path.back() == Position{-1, -1}) {
-        path = random_walk(starting_halite, start, dest);
+        path = random_walk(starting_halite, start, dest, rng);
     }
 
     assert(path[0] == start);
@@ -749,7 +704,7 @@ vector<Direction> GameMap::plan_min_cost_route(VVP parents, int starting_halite,
             if (path[i] == max_halite_pos) {
                 tmp_time++;
                 curr_h += at(curr)->gain();
-                plan_min_cost_route(parents, curr_h, max_halite_pos, dest, tmp_time);
+                plan_min_cost_route(bfs, curr_h, max_halite_pos, dest, rng, tmp_time);
                 if (max_halite_pos == start) {
                     return vector<Direction>(1, Direction::STILL);
                 }
@@ -758,50 +713,33 @@ vector<Direction> GameMap::plan_min_cost_route(VVP parents, int starting_halite,
             tmp_time += 1;
             curr_h -= at(curr)->cost();
         }
-        return minCostOptions(parents, start, dest);
+        return minCostOptions(bfs, start, dest);
     }
 
     for (auto p : path) {
         addPlanned(time, p);
         time++;
     }
-    return minCostOptions(parents, start, dest);
+    return minCostOptions(bfs, start, dest);
 }
 
 
-int GameMap::getPathLength(VVP &pos, Position start, Position dest) {
+int GameMap::getPathLength(PathView bfs, Position start, Position dest) {
     if (start == dest) {
         return 1;
     }
-    if (pos[dest.x][dest.y] == Position {-1, -1}) {
-        return -1;
-    }
-    Position curr = dest;
-    int length = 0;
-    while (curr != start) {
-        auto tmp = pos[curr.x][curr.y];
-        curr = tmp;
-        length++;
-    }
-
-    return length;
+    return bfs.depth(dest);
 }
 
-vector<Direction> GameMap::minCostOptions(VVP &pos, Position start, Position dest) {
+vector<Direction> GameMap::minCostOptions(PathView bfs, Position start, Position dest) {
     if (start == dest) {
         return vector<Direction>(1, Direction::STILL);
     }
-    if (pos[dest.x][dest.y] == Position {-1, -1}) {
+    if (bfs.depth(dest) < 0) {
         //assert(false);
         return get_unsafe_moves(start, dest);
     }
-    Position curr = dest;
-    Direction move = Direction::STILL;
-    while (curr != start) {
-        auto tmp = pos[curr.x][curr.y];
-        move = getDirectDiff(tmp, curr);
-        curr = tmp;
-    }
+    Direction move = bfs.first_move(dest);
 
     vector<Direction> opts;
     opts.push_back(move);
@@ -837,43 +775,48 @@ Position GameMap::normalize(const Position& position) {
 
 
 bool GameMap::canMove(std::shared_ptr<Ship> ship) {
-    return at(ship)->halite * 0.1 <= ship->halite;
+    return mining::move_cost(at(ship)->halite) <= ship->halite;
 }
 
 std::vector<Direction> GameMap::get_unsafe_moves(const Position& source, const Position& destination) {
-    const auto& normalized_source = normalize(source);
-    const auto& normalized_destination = normalize(destination);
-
     if (source == destination) {
         return std::vector<Direction>(1, Direction::STILL);
     }
+    Direction moves[2];
+    int count = get_unsafe_moves(source, destination, moves);
+    return std::vector<Direction>(moves, moves + count);
+}
+
+int GameMap::get_unsafe_moves(const Position& source, const Position& destination, Direction moves[2]) {
+    const auto& normalized_source = normalize(source);
+    const auto& normalized_destination = normalize(destination);
 
     const int dx = std::abs(normalized_source.x - normalized_destination.x);
     const int dy = std::abs(normalized_source.y - normalized_destination.y);
     const int wrapped_dx = width - dx;
     const int wrapped_dy = height - dy;
 
-    std::vector<Direction> possible_moves;
+    int count = 0;
 
     if (normalized_source.x < normalized_destination.x) {
-        possible_moves.push_back(dx > wrapped_dx ? Direction::WEST : Direction::EAST);
+        moves[count++] = dx > wrapped_dx ? Direction::WEST : Direction::EAST;
     } else if (normalized_source.x > normalized_destination.x) {
-        possible_moves.push_back(dx < wrapped_dx ? Direction::WEST : Direction::EAST);
+        moves[count++] = dx < wrapped_dx ? Direction::WEST : Direction::EAST;
     }
 
     if (normalized_source.y < normalized_destination.y) {
-        possible_moves.push_back(dy > wrapped_dy ? Direction::NORTH : Direction::SOUTH);
+        moves[count++] = dy > wrapped_dy ? Direction::NORTH : Direction::SOUTH;
     } else if (normalized_source.y > normalized_destination.y) {
-        possible_moves.push_back(dy < wrapped_dy ? Direction::NORTH : Direction::SOUTH);
+        moves[count++] = dy < wrapped_dy ? Direction::NORTH : Direction::SOUTH;
     }
 
-    if (dy > dx && possible_moves.size() >= 2) {
-        auto tmp = possible_moves[0];
-        possible_moves[0] = possible_moves[1];
-        possible_moves[1] = tmp;
+    if (dy > dx && count >= 2) {
+        auto tmp = moves[0];
+        moves[0] = moves[1];
+        moves[1] = tmp;
     }
 
-    return possible_moves;
+    return count;
 }
 
 bool GameMap::is_in_range_of_enemy(Position p, PlayerId pl, bool on_square) {
@@ -1068,13 +1011,8 @@ double GameMap::costfn(Ship *s, int to_cost, int home_cost, Position shipyard, P
 
     int curr_hal = s->halite;
     double out = -1000;
-    int mined = 0;
     for (int i = 0; i<5; i++) {
-        mined += halite * 0.25;
-        if (inspired) {
-            mined += halite * 0.5;
-        }
-        halite *= 0.75;
+        int mined = mining::gained(halite, i + 1, inspired);
         if (mined + curr_hal > 1000) {
             mined = 1000 - curr_hal;
         }
@@ -1100,13 +1038,13 @@ int GameMap::num_inspired(Position p, PlayerId id) {
             if (this->calculate_distance(c, p) <= constants::INSPIRATION_RADIUS) {
                 if (at(c)->occupied_by_not(id)) {
                     if (is_inspired(c, id, true)) {
-                        count += 2 * 0.25 * at(c)->halite;
+                        count += mining::inspired_bonus(at(c)->halite);
                     }
                 }
                 if (is_inspired(p, constants::PID)) {
                     if (at(c)->is_occupied(constants::PID)) {
                         if (is_inspired(c, constants::PID)) {
-                            count -= 2 * 0.25 * at(c)->halite;
+                            count -= mining::inspired_bonus(at(c)->halite);
                         }
                     }
                 }
@@ -1138,6 +1076,26 @@ bool GameMap::likely_inspired(Position p, int turns) {
     return likelyInspiredMemo[make_pair(p, turns)] = enemies >= 4;
 }
 
+void GameMap::prepare_rollouts() {
+    rollout_grid.width = width;
+    rollout_grid.height = height;
+    rollout_grid.halite.assign(width * height, 0);
+    rollout_grid.inspired.assign(width * height, 0);
+    rollout_grid.enemy_cargo.assign(width * height, 0);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int c = y * width + x;
+            MapCell *cell = at(x, y);
+            rollout_grid.halite[c] = cell->halite;
+            // likely_inspired is currently just is_inspired for our own id
+            rollout_grid.inspired[c] = is_inspired(Position(x, y), constants::PID);
+            if (cell->occupied_by_not(constants::PID)) {
+                rollout_grid.enemy_cargo[c] = cell->ship->halite;
+            }
+        }
+    }
+}
+
 bool GameMap::is_inspired(Position p, PlayerId id, bool enemy) {
     if (!constants::INSPIRATION_ENABLED) return false;
     if (inspiredMemo.count(p)) return inspiredMemo[p];
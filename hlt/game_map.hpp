@@ -3,6 +3,12 @@
 #include "types.hpp"
 #include "map_cell.hpp"
 #include "player.hpp"
+#include "random.hpp"
+#include "rollout.hpp"
+#include "rollout_cache.hpp"
+#include "ship_plans.hpp"
+#include "reservation_table.hpp"
+#include "halite_overlay.hpp"
 
 #include <cassert>
 #include <vector>
@@ -40,19 +46,21 @@ namespace hlt {
 
         int width;
         int height;
-        std::vector<std::vector<MapCell>> cells;
+        // row major, y * width + x
+        std::vector<MapCell> cells;
         map<pair<Position, int>, bool> likelyInspiredMemo;
 
         // Planning for the future: planned = planned + set
-        std::set<TimePos> planned_route;
+        ReservationTable planned_route;
         // std::map<Position, int> future_halite;
 
         unordered_map<Position, int> inspiredCountMemo;
 
-        std::map<Position, set<int>> hal_mp;
+        // mining the current plan does, see hal_at
+        HaliteOverlay hal_plan;
 
         // set_route contains the next turn state.
-        std::map<TimePos, Ship*> set_route;
+        ReservationTable set_route;
 
         std::unordered_map<Position, Position> closestDropMp;
 
@@ -102,11 +110,11 @@ namespace hlt {
 
         BFSR BFS(Position source, bool collide=false, int starting_hal=0);
 
-        vector<Position> traceBackPath(VVP parents, Position start, Position dest);
+        void traceBackPath(PathView bfs, Position start, Position dest, vector<Position> &path);
 
-        void random_walk(VC<Position> &walk, int length, int seed);
+        void random_walk(VC<Position> &walk, int length, int seed, Rng &rng);
 
-        VC<Position> random_walk(int starting_halite, Position start, Position dest);
+        VC<Position> random_walk(int starting_halite, Position start, Position dest, Rng &rng);
 
         VC<Position> wait_adjust(int starting_halite, VC<Position> walk, int turn);
 
@@ -116,23 +124,23 @@ namespace hlt {
 
         int getPathCost(VC<Position> p);
 
-        vector<Position> hc_plan_gather_path(int starting_halite, Position start, Position end, vector<Position> starting_path);
+        vector<Position> hc_plan_gather_path(int starting_halite, Position start, Position end, vector<Position> starting_path, Rng &rng);
 
-        vector<Position> hc_plan_gather_path(int starting_halite, Position start, vector<Position> starting_path);
+        vector<Position> hc_plan_gather_path(int starting_halite, Position start, vector<Position> starting_path, Rng &rng);
 
-        vector<Direction> plan_gather_path(int starting_halite, Position start, Position dest);
+        vector<Direction> plan_gather_path(int starting_halite, Position start, Position dest, Rng &rng);
 
-        RandomWalkResult get_best_random_walk(int starting_halite, Position start, Position dest, Order& order, double time_bank = 0);
+        RandomWalkResult get_best_random_walk(int starting_halite, Position start, Position dest, Order& order, Rng &rng, double time_bank = 0);
 
         bool likely_inspired(Position p, int turns);
 
-        Direction get_random_dir_towards(Position start, Position end);
+        Direction get_random_dir_towards(Position start, Position end, Rng &rng);
 
-        vector<Direction> plan_min_cost_route(VVP parents, int starting_halite, Position start, Position dest, int time = 1);
+        vector<Direction> plan_min_cost_route(PathView bfs, int starting_halite, Position start, Position dest, Rng &rng, int time = 1);
 
-        vector<Direction> minCostOptions(VVP &pos, Position start, Position dest);
+        vector<Direction> minCostOptions(PathView bfs, Position start, Position dest);
 
-        int getPathLength(VVP &pars, Position start, Position dest);
+        int getPathLength(PathView bfs, Position start, Position dest);
 
         int calculate_distance(const Position& source, const Position& target);
 
@@ -141,6 +149,8 @@ namespace hlt {
         bool canMove(std::shared_ptr<Ship> ship);
 
         std::vector<Direction> get_unsafe_moves(const Position& source, const Position& destination);
+        // Same moves without allocating; fills moves and returns how many (0 if already there).
+        int get_unsafe_moves(const Position& source, const Position& destination, Direction moves[2]);
 
         bool is_in_range_of_enemy(Position p, PlayerId pl, bool on_square=false);
 
@@ -171,6 +181,21 @@ namespace hlt {
 
         bool is_inspired(Position p, PlayerId id, bool enemy=false);
 
+        // Flat map snapshot for get_best_random_walk. prepare_rollouts() fills it on the
+        // main thread so rollouts on worker threads only read it, never the memos.
+        RolloutGrid rollout_grid;
+
+        // walk results from earlier turns, see get_best_random_walk
+        RolloutCache rollout_cache;
+
+        // each ship's current walk, see get_best_random_walk
+        ShipPlans ship_plans;
+
+        // True if get_best_random_walk can answer from a plan or the cache.
+        bool has_cached_walk(int starting_halite, Position start, Position dest, EntityId id = -1);
+
+        void prepare_rollouts();
+
         vector<Position> get_surrounding_pos(Position p, bool inclusive=true);
 
         int sum_around_point(Position p, int r);
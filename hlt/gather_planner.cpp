@@ -0,0 +1,205 @@
+#include "gather_planner.hpp"
+#include "mining.hpp"
+
+#include <algorithm>
+
+using namespace hlt;
+
+static const int LAYER = (GatherPlanner::MAX_STAYS + 1) * (GatherPlanner::MAX_STAYS + 1);
+
+GatherPlanner::Box GatherPlanner::make_box(const RolloutGrid &grid, int start, int dest) {
+    // same direction choice as get_unsafe_moves, which a monotone walk keeps all the way
+    int x = start % grid.width, y = start / grid.width;
+    int tx = dest % grid.width, ty = dest / grid.width;
+    int dx = abs(x - tx), dy = abs(y - ty);
+
+    Box box;
+    box.x0 = x;
+    box.y0 = y;
+    bool west = x < tx ? dx > grid.width - dx : dx < grid.width - dx;
+    bool north = y < ty ? dy > grid.height - dy : dy < grid.height - dy;
+    box.step_x = x == tx ? 0 : west ? -1 : 1;
+    box.step_y = y == ty ? 0 : north ? -1 : 1;
+    box.size_x = box.step_x == 0 ? 0 : ((tx - x) * box.step_x + grid.width) % grid.width;
+    box.size_y = box.step_y == 0 ? 0 : ((ty - y) * box.step_y + grid.height) % grid.height;
+    return box;
+}
+
+bool GatherPlanner::fits(const RolloutGrid &grid, int start_cell, int dest_cell) {
+    Box box = make_box(grid, start_cell, dest_cell);
+    return (box.size_x + 1) * (box.size_y + 1) * LAYER <= MAX_STATES;
+}
+
+int GatherPlanner::cell_at(int i, int j) const {
+    int x = (box.x0 + i * box.step_x + grid->width) % grid->width;
+    int y = (box.y0 + j * box.step_y + grid->height) % grid->height;
+    return y * grid->width + x;
+}
+
+int GatherPlanner::state(int i, int j, int stays, int here) const {
+    return (i * (box.size_y + 1) + j) * LAYER + stays * (MAX_STAYS + 1) + here;
+}
+
+void GatherPlanner::solve(const RolloutGrid &grid, int start_cell, int dest_cell, int starting_halite,
+                          RolloutTally &tally, vector<Position> &path) {
+    this->grid = &grid;
+    box = make_box(grid, start_cell, dest_cell);
+    start = start_cell;
+    dest = dest_cell;
+    this->starting_halite = starting_halite;
+    path.clear();
+
+    int cells = (box.size_x + 1) * (box.size_y + 1);
+    mined_halite.resize(cells * (MAX_STAYS + 1));
+    mined_gain.resize(cells * (MAX_STAYS + 1));
+    for (int i = 0; i <= box.size_x; i++) {
+        for (int j = 0; j <= box.size_y; j++) {
+            int c = cell_at(i, j);
+            int base = (i * (box.size_y + 1) + j) * (MAX_STAYS + 1);
+            int h = grid.halite[c];
+            for (int k = 0; k <= MAX_STAYS; k++) {
+                mined_halite[base + k] = h;
+                mined_gain[base + k] = mining::gain(h, grid.inspired[c]);
+                h -= mining::extract(h, grid.inspired[c]);
+            }
+        }
+    }
+    cargo.resize(cells * LAYER);
+    from.resize(cells * LAYER);
+
+    // the first action decides the tally slot, so each one gets its own DP
+    int h = mined_halite[0];
+    struct First {
+        Direction move;
+        int i, j, stays, cargo;
+    };
+    First firsts[3];
+    int count = 0;
+    firsts[count++] = {Direction::STILL, 0, 0, 1, starting_halite + mined_gain[0]};
+    if (starting_halite >= mining::move_cost(h)) {
+        int moved = starting_halite - mining::move_cost(h);
+        if (box.size_x > 0) {
+            firsts[count++] = {box.step_x > 0 ? Direction::EAST : Direction::WEST, 1, 0, 0, moved};
+        }
+        if (box.size_y > 0) {
+            firsts[count++] = {box.step_y > 0 ? Direction::SOUTH : Direction::NORTH, 0, 1, 0, moved};
+        }
+    }
+
+    for (int f = 0; f < count; f++) {
+        const First &first = firsts[f];
+        RolloutEnd end;
+        double cost = 0;
+        int turns = 0;
+        int last = -1;
+        bool arrived = first.i == box.size_x && first.j == box.size_y;
+        if (first.cargo >= 900 || arrived) {
+            // finished on the first action
+            end.cargo = first.cargo;
+            end.turns = 2;
+            end.end_cell = arrived ? dest : start;
+            end.did_break = first.cargo >= 900;
+            end.first_move = first.move;
+            end.index = 0;
+            cost = rollout_score(grid, dest, starting_halite, end, turns);
+        }
+        else if (!run(first.i, first.j, first.stays, first.cargo, first.move, end, cost, turns, last)) {
+            continue;
+        }
+
+        bool improves = cost > tally.best_cost;
+        tally.add(end, cost, turns);
+        if (improves) {
+            trace(last, path);
+        }
+    }
+}
+
+bool GatherPlanner::run(int first_i, int first_j, int first_stays, int first_cargo, Direction first_move,
+                        RolloutEnd &best_end, double &best_cost, int &best_turns, int &best_last) {
+    fill(cargo.begin(), cargo.end(), -1);
+    int first = state(first_i, first_j, first_stays, first_stays);
+    cargo[first] = first_cargo;
+    from[first] = -1;
+
+    bool found = false;
+    auto finish = [&](int c, int turns, int cell, bool did_break, int last) {
+        RolloutEnd end;
+        end.cargo = c;
+        end.turns = turns;
+        end.end_cell = cell;
+        end.did_break = did_break;
+        end.first_move = first_move;
+        end.index = 0;
+        int score_turns;
+        double cost = rollout_score(*grid, dest, starting_halite, end, score_turns);
+        if (!found || cost > best_cost) {
+            found = true;
+            best_end = end;
+            best_cost = cost;
+            best_turns = score_turns;
+            best_last = last;
+        }
+    };
+
+    // predecessors are always at a lower i or j, or at fewer stays on the same cell
+    for (int i = 0; i <= box.size_x; i++) {
+        for (int j = 0; j <= box.size_y; j++) {
+            if (i == box.size_x && j == box.size_y) continue;
+            int cell = cell_at(i, j);
+            int base = (i * (box.size_y + 1) + j) * (MAX_STAYS + 1);
+            for (int stays = 0; stays <= MAX_STAYS; stays++) {
+                // the walk's turn counter once this state takes its next action
+                int turns = 2 + i + j + stays;
+                for (int here = 0; here <= stays; here++) {
+                    int s = state(i, j, stays, here);
+                    int c = cargo[s];
+                    if (c < 0) continue;
+
+                    if (stays < MAX_STAYS) {
+                        int mined = c + mined_gain[base + here];
+                        if (mined >= 900) {
+                            finish(mined, turns, cell, true, s);
+                        }
+                        else {
+                            int n = state(i, j, stays + 1, here + 1);
+                            if (mined > cargo[n]) {
+                                cargo[n] = mined;
+                                from[n] = s;
+                            }
+                        }
+                    }
+
+                    int cost = mining::move_cost(mined_halite[base + here]);
+                    if (c < cost) continue;
+                    int moved = c - cost;
+                    for (int d = 0; d < 2; d++) {
+                        int ni = i + (d == 0), nj = j + (d == 1);
+                        if (ni > box.size_x || nj > box.size_y) continue;
+                        if (ni == box.size_x && nj == box.size_y) {
+                            finish(moved, turns, dest, false, s);
+                            continue;
+                        }
+                        int n = state(ni, nj, stays, 0);
+                        if (moved > cargo[n]) {
+                            cargo[n] = moved;
+                            from[n] = s;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return found;
+}
+
+void GatherPlanner::trace(int last, vector<Position> &path) const {
+    path.clear();
+    for (int s = last; s >= 0; s = from[s]) {
+        int c = s / LAYER;
+        int cell = cell_at(c / (box.size_y + 1), c % (box.size_y + 1));
+        path.push_back(Position(cell % grid->width, cell / grid->width));
+    }
+    path.push_back(Position(start % grid->width, start / grid->width));
+    reverse(path.begin(), path.end());
+}
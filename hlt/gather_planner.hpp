@@ -0,0 +1,61 @@
+#pragma once
+
+#include "rollout.hpp"
+#include "types.hpp"
+
+#include <vector>
+
+using namespace std;
+namespace hlt {
+
+    // Exact version of the gather rollouts. Every walk RolloutBatch can sample
+    // moves monotonically inside the start/dest box and stays (mines) at will,
+    // so the best one is found by DP over (cell, stays so far, stays on this
+    // cell), keeping the most cargo per state. Deterministic, and for small
+    // boxes far cheaper than thousands of samples.
+    //
+    // Not covered: walks staying more than MAX_STAYS turns in total, and the
+    // 900 cargo cut-off, where more cargo is still taken to be better even
+    // though it can end a walk before it reaches dest.
+    class GatherPlanner {
+    public:
+        static const int MAX_STAYS = 16;
+        static const int MAX_STATES = 1 << 17;
+
+        // True if the box between start and dest is small enough to solve.
+        static bool fits(const RolloutGrid &grid, int start_cell, int dest_cell);
+
+        // Fills tally with the best walk for every possible first move, as the
+        // batch would with unlimited samples, and path with the cells the best
+        // walk stands on before dest (empty if nothing beat the tally's floor).
+        void solve(const RolloutGrid &grid, int start_cell, int dest_cell, int starting_halite,
+                   RolloutTally &tally, vector<Position> &path);
+
+    private:
+        struct Box {
+            int x0, y0, step_x, step_y, size_x, size_y;
+        };
+
+        static Box make_box(const RolloutGrid &grid, int start_cell, int dest_cell);
+
+        int cell_at(int i, int j) const;
+        int state(int i, int j, int stays, int here) const;
+        // one DP from the state the first action leads to; false if nothing finished
+        bool run(int first_i, int first_j, int first_stays, int first_cargo, Direction first_move,
+                 RolloutEnd &best_end, double &best_cost, int &best_turns, int &best_last);
+        void trace(int last, vector<Position> &path) const;
+
+        const RolloutGrid *grid = nullptr;
+        Box box;
+        int dest = 0;
+        int start = 0;
+        int starting_halite = 0;
+
+        // halite and mining gain of each box cell after k stays, k <= MAX_STAYS
+        vector<int> mined_halite;
+        vector<int> mined_gain;
+        // best cargo per state (-1 unreached) and the state it came from (-1 for the first)
+        vector<int> cargo;
+        vector<int> from;
+    };
+}
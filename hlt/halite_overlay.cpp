@@ -0,0 +1,51 @@
+#include "halite_overlay.hpp"
+
+using namespace hlt;
+
+void HaliteOverlay::resize(int cells) {
+    heads.assign(cells, -1);
+    stamp.assign(cells, 0);
+    reset();
+}
+
+void HaliteOverlay::reset() {
+    journal.clear();
+    marks.clear();
+    generation++;
+}
+
+void HaliteOverlay::mine(int cell, int turn) {
+    int h = head(cell);
+    for (int i = h; i != -1; i = journal[i].prev) {
+        if (journal[i].turn == turn) return;
+    }
+    journal.push_back(Mine{cell, turn, h});
+    heads[cell] = (int)journal.size() - 1;
+    stamp[cell] = generation;
+}
+
+int HaliteOverlay::uses(int cell, int turn) const {
+    int count = 0;
+    for (int i = head(cell); i != -1; i = journal[i].prev) {
+        count += journal[i].turn < turn;
+    }
+    return count;
+}
+
+void HaliteOverlay::fork() {
+    marks.push_back((int)journal.size());
+}
+
+void HaliteOverlay::rollback() {
+    int mark = marks.back();
+    marks.pop_back();
+    while ((int)journal.size() > mark) {
+        const Mine &m = journal.back();
+        heads[m.cell] = m.prev;
+        journal.pop_back();
+    }
+}
+
+void HaliteOverlay::commit() {
+    marks.pop_back();
+}
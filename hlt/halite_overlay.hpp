@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+namespace hlt {
+
+    // Planned mining on top of the map's halite: a journal of (cell, turn) mines
+    // with a per-cell chain through it, so asking how often a cell has been
+    // mined before some turn only walks that cell's own mines. fork() marks the
+    // journal; rollback() drops everything since the mark and commit() keeps it,
+    // which lets a planner try a walk, score it and throw it away without
+    // touching the shared plan. Forks nest. reset() is O(1). Cells are
+    // y * width + x.
+    class HaliteOverlay {
+    public:
+        void resize(int cells);
+
+        // Drops every mine and any open fork.
+        void reset();
+
+        // The cell gets mined on turn; halite queries after that turn see it.
+        // Mining the same cell twice on one turn counts once.
+        void mine(int cell, int turn);
+
+        // Mines on cell strictly before turn.
+        int uses(int cell, int turn) const;
+
+        void fork();
+
+        void rollback();
+
+        void commit();
+
+    private:
+        struct Mine {
+            int cell;
+            int turn;
+            int prev;
+        };
+
+        int head(int cell) const {
+            return stamp[cell] == generation ? heads[cell] : -1;
+        }
+
+        vector<Mine> journal;
+        vector<int> heads;
+        vector<uint32_t> stamp;
+        vector<int> marks;
+        uint32_t generation = 1;
+    };
+}
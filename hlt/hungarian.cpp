@@ -12,81 +12,148 @@
 #include <stdlib.h>
 #include <cfloat> // for DBL_MAX
 #include <cmath>  // for fabs()
+#include <algorithm>
 #include "hungarian.hpp"
 
 
 HungarianAlgorithm::HungarianAlgorithm(){}
 HungarianAlgorithm::~HungarianAlgorithm(){}
 
+HungarianWorkspace::HungarianWorkspace(){}
+HungarianWorkspace::~HungarianWorkspace()
+{
+	free(distMatrix);
+	free(assignment);
+	free(coveredColumns);
+	free(coveredRows);
+	free(starMatrix);
+	free(primeMatrix);
+	free(newStarMatrix);
+}
+
+//********************************************************//
+// Grow the scratch buffers to fit a nRows x nCols problem. Buffers are only
+// ever grown, so a workspace reused across turns stops allocating quickly.
+//********************************************************//
+void HungarianWorkspace::reserve(int nRows, int nCols)
+{
+	int nElements = nRows * nCols;
+	if (nElements > elementCapacity)
+	{
+		free(distMatrix);
+		free(starMatrix);
+		free(primeMatrix);
+		free(newStarMatrix);
+		distMatrix = (double *)malloc(nElements * sizeof(double));
+		starMatrix = (bool *)malloc(nElements * sizeof(bool));
+		primeMatrix = (bool *)malloc(nElements * sizeof(bool));
+		newStarMatrix = (bool *)malloc(nElements * sizeof(bool));
+		elementCapacity = nElements;
+	}
+	if (nRows > rowCapacity)
+	{
+		free(assignment);
+		free(coveredRows);
+		assignment = (int *)malloc(nRows * sizeof(int));
+		coveredRows = (bool *)malloc(nRows * sizeof(bool));
+		rowCapacity = nRows;
+	}
+	if (nCols > columnCapacity)
+	{
+		free(coveredColumns);
+		coveredColumns = (bool *)malloc(nCols * sizeof(bool));
+		columnCapacity = nCols;
+	}
+}
+
 
 //********************************************************//
 // A single function wrapper for solving assignment problem.
 //********************************************************//
 double HungarianAlgorithm::Solve(vector <vector<double> >& DistMatrix, vector<int>& Assignment)
 {
-	unsigned int nRows = DistMatrix.size();
-	unsigned int nCols = DistMatrix[0].size();
+	int nRows = DistMatrix.size();
+	int nCols = DistMatrix[0].size();
+
+	// Rows are copied straight into the (row-major) working matrix.
+	workspace.reserve(nRows, nCols);
+	for (int i = 0; i < nRows; i++)
+		std::copy(DistMatrix[i].begin(), DistMatrix[i].end(), workspace.distMatrix + i * nCols);
 
-	double *distMatrixIn = new double[nRows * nCols];
-	int *assignment = new int[nRows];
 	double cost = 0.0;
+	assignmentoptimal(workspace, &cost, DistMatrix[0].data(), 0, nRows, nCols);
+	for (int i = 0; i < nRows; i++)
+		if (workspace.assignment[i] >= 0)
+			cost += DistMatrix[i][workspace.assignment[i]];
 
-	// Fill in the distMatrixIn. Mind the index is "i + nRows * j".
-	// Here the cost matrix of size MxN is defined as a double precision array of N*M elements. 
-	// In the solving functions matrices are seen to be saved MATLAB-internally in row-order.
-	// (i.e. the matrix [1 2; 3 4] will be stored as a vector [1 3 2 4], NOT [1 2 3 4]).
-	for (unsigned int i = 0; i < nRows; i++)
-		for (unsigned int j = 0; j < nCols; j++)
-			distMatrixIn[i + nRows * j] = DistMatrix[i][j];
-	
-	// call solving function
-	assignmentoptimal(assignment, &cost, distMatrixIn, nRows, nCols);
-
-	Assignment.clear();
-	for (unsigned int r = 0; r < nRows; r++)
-		Assignment.push_back(assignment[r]);
-
-	delete[] distMatrixIn;
-	delete[] assignment;
+	Assignment.assign(workspace.assignment, workspace.assignment + nRows);
+	return cost;
+}
+
+//********************************************************//
+// Solve a nRows x nCols problem stored row-major at DistMatrix[row * RowStride + col].
+// The caller keeps ownership of the costs; all scratch memory comes from Workspace.
+// Rows may not overlap, so RowStride has to be at least nCols.
+//********************************************************//
+double HungarianAlgorithm::Solve(const double *DistMatrix, int nRows, int nCols, int RowStride, vector<int>& Assignment, HungarianWorkspace& Workspace)
+{
+	if (RowStride < nCols)
+	{
+		// a stride of 0 would also make assignmentoptimal reuse whatever the workspace holds
+		cerr << "Row stride has to be at least the number of columns." << endl;
+		Assignment.assign(nRows, -1);
+		return 0.0;
+	}
+	Workspace.reserve(nRows, nCols);
+
+	double cost = 0.0;
+	assignmentoptimal(Workspace, &cost, DistMatrix, RowStride, nRows, nCols);
+
+	Assignment.assign(Workspace.assignment, Workspace.assignment + nRows);
 	return cost;
 }
 
 
 //********************************************************//
 // Solve optimal solution for assignment problem using Munkres algorithm, also known as Hungarian Algorithm.
+// With rowStride 0 the working matrix is assumed to be filled already and no cost is computed.
 //********************************************************//
-void HungarianAlgorithm::assignmentoptimal(int *assignment, double *cost, double *distMatrixIn, int nOfRows, int nOfColumns)
+void HungarianAlgorithm::assignmentoptimal(HungarianWorkspace &ws, double *cost, const double *distMatrixIn, int rowStride, int nOfRows, int nOfColumns)
 {
-	double *distMatrix, *distMatrixTemp, *distMatrixEnd, *columnEnd, value, minValue;
+	double *distMatrix, *distMatrixTemp, *rowEnd, value, minValue;
 	bool *coveredColumns, *coveredRows, *starMatrix, *newStarMatrix, *primeMatrix;
+	int *assignment;
 	int nOfElements, minDim, row, col;
 
+	nOfElements = nOfRows * nOfColumns;
+	distMatrix = ws.distMatrix;
+	assignment = ws.assignment;
+	coveredColumns = ws.coveredColumns;
+	coveredRows = ws.coveredRows;
+	starMatrix = ws.starMatrix;
+	primeMatrix = ws.primeMatrix;
+	newStarMatrix = ws.newStarMatrix; /* used in step4 */
+
 	/* initialization */
 	*cost = 0;
 	for (row = 0; row<nOfRows; row++)
 		assignment[row] = -1;
 
 	/* generate working copy of distance Matrix */
-	/* check if all matrix elements are positive */
-	nOfElements = nOfRows * nOfColumns;
-	distMatrix = (double *)malloc(nOfElements * sizeof(double));
-	distMatrixEnd = distMatrix + nOfElements;
+	if (rowStride != 0)
+		for (row = 0; row<nOfRows; row++)
+			std::copy(distMatrixIn + row * rowStride, distMatrixIn + row * rowStride + nOfColumns, distMatrix + row * nOfColumns);
 
+	/* check if all matrix elements are positive */
 	for (row = 0; row<nOfElements; row++)
-	{
-		value = distMatrixIn[row];
-		if (value < 0)
+		if (distMatrix[row] < 0)
 			cerr << "All matrix elements have to be non-negative." << endl;
-		distMatrix[row] = value;
-	}
-
 
-	/* memory allocation */
-	coveredColumns = (bool *)calloc(nOfColumns, sizeof(bool));
-	coveredRows = (bool *)calloc(nOfRows, sizeof(bool));
-	starMatrix = (bool *)calloc(nOfElements, sizeof(bool));
-	primeMatrix = (bool *)calloc(nOfElements, sizeof(bool));
-	newStarMatrix = (bool *)calloc(nOfElements, sizeof(bool)); /* used in step4 */
+	std::fill(coveredColumns, coveredColumns + nOfColumns, false);
+	std::fill(coveredRows, coveredRows + nOfRows, false);
+	std::fill(starMatrix, starMatrix + nOfElements, false);
+	std::fill(primeMatrix, primeMatrix + nOfElements, false);
+	std::fill(newStarMatrix, newStarMatrix + nOfElements, false);
 
 	/* preliminary steps */
 	if (nOfRows <= nOfColumns)
@@ -96,33 +163,29 @@ void HungarianAlgorithm::assignmentoptimal(int *assignment, double *cost, double
 		for (row = 0; row<nOfRows; row++)
 		{
 			/* find the smallest element in the row */
-			distMatrixTemp = distMatrix + row;
-			minValue = *distMatrixTemp;
-			distMatrixTemp += nOfRows;
-			while (distMatrixTemp < distMatrixEnd)
+			distMatrixTemp = distMatrix + row*nOfColumns;
+			rowEnd = distMatrixTemp + nOfColumns;
+			minValue = *distMatrixTemp++;
+			while (distMatrixTemp < rowEnd)
 			{
-				value = *distMatrixTemp;
+				value = *distMatrixTemp++;
 				if (value < minValue)
 					minValue = value;
-				distMatrixTemp += nOfRows;
 			}
 
 			/* subtract the smallest element from each element of the row */
-			distMatrixTemp = distMatrix + row;
-			while (distMatrixTemp < distMatrixEnd)
-			{
-				*distMatrixTemp -= minValue;
-				distMatrixTemp += nOfRows;
-			}
+			distMatrixTemp = distMatrix + row*nOfColumns;
+			while (distMatrixTemp < rowEnd)
+				*distMatrixTemp++ -= minValue;
 		}
 
 		/* Steps 1 and 2a */
 		for (row = 0; row<nOfRows; row++)
 			for (col = 0; col<nOfColumns; col++)
-				if (fabs(distMatrix[row + nOfRows*col]) < DBL_EPSILON)
+				if (fabs(distMatrix[row*nOfColumns + col]) < DBL_EPSILON)
 					if (!coveredColumns[col])
 					{
-						starMatrix[row + nOfRows*col] = true;
+						starMatrix[row*nOfColumns + col] = true;
 						coveredColumns[col] = true;
 						break;
 					}
@@ -134,30 +197,26 @@ void HungarianAlgorithm::assignmentoptimal(int *assignment, double *cost, double
 		for (col = 0; col<nOfColumns; col++)
 		{
 			/* find the smallest element in the column */
-			distMatrixTemp = distMatrix + nOfRows*col;
-			columnEnd = distMatrixTemp + nOfRows;
-
-			minValue = *distMatrixTemp++;
-			while (distMatrixTemp < columnEnd)
+			minValue = distMatrix[col];
+			for (row = 1; row<nOfRows; row++)
 			{
-				value = *distMatrixTemp++;
+				value = distMatrix[row*nOfColumns + col];
 				if (value < minValue)
 					minValue = value;
 			}
 
 			/* subtract the smallest element from each element of the column */
-			distMatrixTemp = distMatrix + nOfRows*col;
-			while (distMatrixTemp < columnEnd)
-				*distMatrixTemp++ -= minValue;
+			for (row = 0; row<nOfRows; row++)
+				distMatrix[row*nOfColumns + col] -= minValue;
 		}
 
 		/* Steps 1 and 2a */
 		for (col = 0; col<nOfColumns; col++)
 			for (row = 0; row<nOfRows; row++)
-				if (fabs(distMatrix[row + nOfRows*col]) < DBL_EPSILON)
+				if (fabs(distMatrix[row*nOfColumns + col]) < DBL_EPSILON)
 					if (!coveredRows[row])
 					{
-						starMatrix[row + nOfRows*col] = true;
+						starMatrix[row*nOfColumns + col] = true;
 						coveredColumns[col] = true;
 						coveredRows[row] = true;
 						break;
@@ -171,15 +230,8 @@ void HungarianAlgorithm::assignmentoptimal(int *assignment, double *cost, double
 	step2b(assignment, distMatrix, starMatrix, newStarMatrix, primeMatrix, coveredColumns, coveredRows, nOfRows, nOfColumns, minDim);
 
 	/* compute cost and remove invalid assignments */
-	computeassignmentcost(assignment, cost, distMatrixIn, nOfRows);
-
-	/* free allocated memory */
-	free(distMatrix);
-	free(coveredColumns);
-	free(coveredRows);
-	free(starMatrix);
-	free(primeMatrix);
-	free(newStarMatrix);
+	if (rowStride != 0)
+		computeassignmentcost(assignment, cost, distMatrixIn, rowStride, nOfRows);
 
 	return;
 }
@@ -191,7 +243,7 @@ void HungarianAlgorithm::buildassignmentvector(int *assignment, bool *starMatrix
 
 	for (row = 0; row<nOfRows; row++)
 		for (col = 0; col<nOfColumns; col++)
-			if (starMatrix[row + nOfRows*col])
+			if (starMatrix[row*nOfColumns + col])
 			{
 #ifdef ONE_INDEXING
 				assignment[row] = col + 1; /* MATLAB-Indexing */
@@ -203,7 +255,7 @@ void HungarianAlgorithm::buildassignmentvector(int *assignment, bool *starMatrix
 }
 
 /********************************************************/
-void HungarianAlgorithm::computeassignmentcost(int *assignment, double *cost, double *distMatrix, int nOfRows)
+void HungarianAlgorithm::computeassignmentcost(int *assignment, double *cost, const double *distMatrix, int rowStride, int nOfRows)
 {
 	int row, col;
 
@@ -211,29 +263,20 @@ void HungarianAlgorithm::computeassignmentcost(int *assignment, double *cost, do
 	{
 		col = assignment[row];
 		if (col >= 0)
-			*cost += distMatrix[row + nOfRows*col];
+			*cost += distMatrix[row*rowStride + col];
 	}
 }
 
 /********************************************************/
 void HungarianAlgorithm::step2a(int *assignment, double *distMatrix, bool *starMatrix, bool *newStarMatrix, bool *primeMatrix, bool *coveredColumns, bool *coveredRows, int nOfRows, int nOfColumns, int minDim)
 {
-	bool *starMatrixTemp, *columnEnd;
-	int col;
+	int row, col;
 
 	/* cover every column containing a starred zero */
-	for (col = 0; col<nOfColumns; col++)
-	{
-		starMatrixTemp = starMatrix + nOfRows*col;
-		columnEnd = starMatrixTemp + nOfRows;
-		while (starMatrixTemp < columnEnd){
-			if (*starMatrixTemp++)
-			{
+	for (row = 0; row<nOfRows; row++)
+		for (col = 0; col<nOfColumns; col++)
+			if (starMatrix[row*nOfColumns + col])
 				coveredColumns[col] = true;
-				break;
-			}
-		}
-	}
 
 	/* move to step 3 */
 	step2b(assignment, distMatrix, starMatrix, newStarMatrix, primeMatrix, coveredColumns, coveredRows, nOfRows, nOfColumns, minDim);
@@ -276,14 +319,14 @@ void HungarianAlgorithm::step3(int *assignment, double *distMatrix, bool *starMa
 		for (col = 0; col<nOfColumns; col++)
 			if (!coveredColumns[col])
 				for (row = 0; row<nOfRows; row++)
-					if ((!coveredRows[row]) && (fabs(distMatrix[row + nOfRows*col]) < DBL_EPSILON))
+					if ((!coveredRows[row]) && (fabs(distMatrix[row*nOfColumns + col]) < DBL_EPSILON))
 					{
 						/* prime zero */
-						primeMatrix[row + nOfRows*col] = true;
+						primeMatrix[row*nOfColumns + col] = true;
 
 						/* find starred zero in current row */
 						for (starCol = 0; starCol<nOfColumns; starCol++)
-							if (starMatrix[row + nOfRows*starCol])
+							if (starMatrix[row*nOfColumns + starCol])
 								break;
 
 						if (starCol == nOfColumns) /* no starred zero found */
@@ -317,32 +360,32 @@ void HungarianAlgorithm::step4(int *assignment, double *distMatrix, bool *starMa
 		newStarMatrix[n] = starMatrix[n];
 
 	/* star current zero */
-	newStarMatrix[row + nOfRows*col] = true;
+	newStarMatrix[row*nOfColumns + col] = true;
 
 	/* find starred zero in current column */
 	starCol = col;
 	for (starRow = 0; starRow<nOfRows; starRow++)
-		if (starMatrix[starRow + nOfRows*starCol])
+		if (starMatrix[starRow*nOfColumns + starCol])
 			break;
 
 	while (starRow<nOfRows)
 	{
 		/* unstar the starred zero */
-		newStarMatrix[starRow + nOfRows*starCol] = false;
+		newStarMatrix[starRow*nOfColumns + starCol] = false;
 
 		/* find primed zero in current row */
 		primeRow = starRow;
 		for (primeCol = 0; primeCol<nOfColumns; primeCol++)
-			if (primeMatrix[primeRow + nOfRows*primeCol])
+			if (primeMatrix[primeRow*nOfColumns + primeCol])
 				break;
 
 		/* star the primed zero */
-		newStarMatrix[primeRow + nOfRows*primeCol] = true;
+		newStarMatrix[primeRow*nOfColumns + primeCol] = true;
 
 		/* find starred zero in current column */
 		starCol = primeCol;
 		for (starRow = 0; starRow<nOfRows; starRow++)
-			if (starMatrix[starRow + nOfRows*starCol])
+			if (starMatrix[starRow*nOfColumns + starCol])
 				break;
 	}
 
@@ -373,7 +416,7 @@ void HungarianAlgorithm::step5(int *assignment, double *distMatrix, bool *starMa
 			for (col = 0; col<nOfColumns; col++)
 				if (!coveredColumns[col])
 				{
-					value = distMatrix[row + nOfRows*col];
+					value = distMatrix[row*nOfColumns + col];
 					if (value < h)
 						h = value;
 				}
@@ -382,13 +425,13 @@ void HungarianAlgorithm::step5(int *assignment, double *distMatrix, bool *starMa
 	for (row = 0; row<nOfRows; row++)
 		if (coveredRows[row])
 			for (col = 0; col<nOfColumns; col++)
-				distMatrix[row + nOfRows*col] += h;
+				distMatrix[row*nOfColumns + col] += h;
 
 	/* subtract h from each uncovered column */
 	for (col = 0; col<nOfColumns; col++)
 		if (!coveredColumns[col])
 			for (row = 0; row<nOfRows; row++)
-				distMatrix[row + nOfRows*col] -= h;
+				distMatrix[row*nOfColumns + col] -= h;
 
 	/* move to step 3 */
 	step3(assignment, distMatrix, starMatrix, newStarMatrix, primeMatrix, coveredColumns, coveredRows, nOfRows, nOfColumns, minDim);
@@ -18,6 +18,36 @@
 using namespace std;
 
 
+// Scratch buffers for HungarianAlgorithm. Keep one alive across solves so
+// repeated per-turn solves stop hitting the heap once it has grown.
+class HungarianWorkspace
+{
+public:
+	HungarianWorkspace();
+	~HungarianWorkspace();
+	HungarianWorkspace(const HungarianWorkspace&) = delete;
+	HungarianWorkspace& operator=(const HungarianWorkspace&) = delete;
+
+	void reserve(int nRows, int nCols);
+
+private:
+	friend class HungarianAlgorithm;
+
+	int elementCapacity = 0;
+	int rowCapacity = 0;
+	int columnCapacity = 0;
+
+	// working copy of the cost matrix, row-major with a stride of nCols
+	double *distMatrix = nullptr;
+	int *assignment = nullptr;
+	bool *coveredColumns = nullptr;
+	bool *coveredRows = nullptr;
+	bool *starMatrix = nullptr;
+	bool *primeMatrix = nullptr;
+	bool *newStarMatrix = nullptr;
+};
+
+
 class HungarianAlgorithm
 {
 public:
@@ -25,10 +55,16 @@ public:
 	~HungarianAlgorithm();
 	double Solve(vector <vector<double> >& DistMatrix, vector<int>& Assignment);
 
+	// Cost of (row, col) is DistMatrix[row * RowStride + col]; the buffer is only read.
+	// RowStride < nCols is rejected: every row is unmatched and the cost is 0.
+	double Solve(const double *DistMatrix, int nRows, int nCols, int RowStride, vector<int>& Assignment, HungarianWorkspace& Workspace);
+
 private:
-	void assignmentoptimal(int *assignment, double *cost, double *distMatrix, int nOfRows, int nOfColumns);
+	HungarianWorkspace workspace;
+
+	void assignmentoptimal(HungarianWorkspace &ws, double *cost, const double *distMatrixIn, int rowStride, int nOfRows, int nOfColumns);
 	void buildassignmentvector(int *assignment, bool *starMatrix, int nOfRows, int nOfColumns);
-	void computeassignmentcost(int *assignment, double *cost, double *distMatrix, int nOfRows);
+	void computeassignmentcost(int *assignment, double *cost, const double *distMatrix, int rowStride, int nOfRows);
 	void step2a(int *assignment, double *distMatrix, bool *starMatrix, bool *newStarMatrix, bool *primeMatrix, bool *coveredColumns, bool *coveredRows, int nOfRows, int nOfColumns, int minDim);
 	void step2b(int *assignment, double *distMatrix, bool *starMatrix, bool *newStarMatrix, bool *primeMatrix, bool *coveredColumns, bool *coveredRows, int nOfRows, int nOfColumns, int minDim);
 	void step3(int *assignment, double *distMatrix, bool *starMatrix, bool *newStarMatrix, bool *primeMatrix, bool *coveredColumns, bool *coveredRows, int nOfRows, int nOfColumns, int minDim);
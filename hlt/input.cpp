@@ -0,0 +1,135 @@
+#include "input.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+namespace {
+    const int BUFFER_SIZE = 1 << 16;
+
+    const char MAGIC[4] = {'H', 'F', 'R', 'M'};
+    const int32_t VERSION = 1;
+
+    char buffer[BUFFER_SIZE];
+    int head = 0;
+    int tail = 0;
+
+    FILE *recording = nullptr;
+    FILE *replay = nullptr;
+
+    void closed() {
+        hlt::log::log("Input connection from server closed. Exiting...");
+        exit(0);
+    }
+
+    // The next chunk of input into buffer, from the engine or the replay; its
+    // size, or <= 0 once there is no more.
+    int fill() {
+        if (replay != nullptr) {
+            int32_t size;
+            if (fread(&size, sizeof(size), 1, replay) != 1 || size <= 0 || size > BUFFER_SIZE) return -1;
+            return fread(buffer, 1, size, replay) == (size_t)size ? size : -1;
+        }
+        ssize_t n;
+        do {
+            n = read(0, buffer, BUFFER_SIZE);
+        } while (n < 0 && errno == EINTR);
+        if (n > 0 && recording != nullptr) {
+            int32_t size = (int32_t)n;
+            fwrite(&size, sizeof(size), 1, recording);
+            fwrite(buffer, 1, n, recording);
+            // the engine may kill us at the end, keep what we have
+            fflush(recording);
+        }
+        return (int)n;
+    }
+
+    // Next byte without consuming it, refilling the buffer once it has been used
+    // up; -1 once the input is gone.
+    int peek() {
+        if (head == tail) {
+            int n = fill();
+            if (n <= 0) return -1;
+            head = 0;
+            tail = n;
+        }
+        return (unsigned char)buffer[head];
+    }
+
+    // Consumes whitespace and newlines; the byte after them, -1 once the input
+    // is gone.
+    int skip_space() {
+        int c = peek();
+        while (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+            head++;
+            c = peek();
+        }
+        return c;
+    }
+}
+
+std::string hlt::get_string() {
+    std::string result;
+    for (;;) {
+        int c = peek();
+        if (c == -1) closed();
+        // take everything up to the newline (or the end of the buffer) at once
+        int start = head;
+        while (head < tail && buffer[head] != '\n') head++;
+        result.append(buffer + start, head - start);
+        if (head < tail) {
+            head++;
+            break;
+        }
+    }
+    if (!result.empty() && result.back() == '\r') result.pop_back();
+    return result;
+}
+
+int hlt::get_int() {
+    int c = skip_space();
+    if (c == -1) closed();
+
+    bool negative = c == '-';
+    if (negative) {
+        head++;
+        c = peek();
+    }
+    int value = 0;
+    while (c >= '0' && c <= '9') {
+        value = value * 10 + (c - '0');
+        head++;
+        c = peek();
+    }
+    return negative ? -value : value;
+}
+
+void hlt::wait_for_input() {
+    if (skip_space() == -1) closed();
+}
+
+bool hlt::record_input(const std::string &path, uint32_t rng_seed) {
+    recording = fopen(path.c_str(), "wb");
+    if (recording == nullptr) return false;
+    fwrite(MAGIC, 1, sizeof(MAGIC), recording);
+    fwrite(&VERSION, sizeof(VERSION), 1, recording);
+    fwrite(&rng_seed, sizeof(rng_seed), 1, recording);
+    return fflush(recording) == 0;
+}
+
+bool hlt::replay_input(const std::string &path, uint32_t &rng_seed) {
+    replay = fopen(path.c_str(), "rb");
+    if (replay == nullptr) return false;
+    char magic[4];
+    int32_t version;
+    if (fread(magic, 1, sizeof(magic), replay) != sizeof(magic) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        fread(&version, sizeof(version), 1, replay) != 1 || version != VERSION ||
+        fread(&rng_seed, sizeof(rng_seed), 1, replay) != 1) {
+        fclose(replay);
+        replay = nullptr;
+        return false;
+    }
+    return true;
+}
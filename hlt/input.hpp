@@ -2,22 +2,38 @@
 
 #include "log.hpp"
 
+#include <cstdint>
 #include <string>
-#include <iostream>
-#include <sstream>
 
 namespace hlt {
-    static std::string get_string() {
-        std::string result;
-        std::getline(std::cin, result);
-        if (!std::cin.good()) {
-            hlt::log::log("Input connection from server closed. Exiting...");
-            exit(0);
-        }
-        return result;
-    }
-
-    static std::stringstream get_sstream() {
-        return std::stringstream(get_string());
-    }
+    // Engine input is read straight off fd 0 into one buffer that lives for the
+    // whole game, and numbers are scanned out of it in place. Everything after
+    // the constants line is whitespace separated integers, so callers just ask
+    // for the next one. Both exit when the engine closes the connection.
+
+    // The rest of the current line, without the newline.
+    std::string get_string();
+
+    // The next integer, skipping any whitespace and newlines before it.
+    int get_int();
+
+    // Blocks until the next integer has started to arrive, without reading it,
+    // so the time spent waiting for the engine can be told apart from parsing.
+    void wait_for_input();
+
+    // Recordings of the engine input, for replaying a game offline. The file is
+    //
+    //   header: "HFRM" int32 version, uint32 rng_seed
+    //   chunk:  int32 size, then size bytes exactly as one read(2) returned them
+    //
+    // Replaying feeds the chunks back through the same parsing, so a bot started
+    // with the same flags and the recorded seed sees the game it saw live. It
+    // only makes the same moves where no time budget ran out.
+
+    // Copies all input from here on into path. Call before anything is read.
+    bool record_input(const std::string &path, uint32_t rng_seed);
+
+    // Reads input from the recording at path instead of the engine; rng_seed gets
+    // the seed the game was played with.
+    bool replay_input(const std::string &path, uint32_t &rng_seed);
 }
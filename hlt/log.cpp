@@ -5,6 +5,7 @@
 #include <iostream>
 #include <vector>
 #include <chrono>
+#include <mutex>
 
 static std::ofstream log_file;
 static std::ofstream flog_file;
@@ -12,6 +13,8 @@ static std::vector<std::string> log_buffer;
 static std::vector<std::string> flog_buffer(1, "[");
 static bool has_opened = false;
 static bool has_atexit = false;
+// rollouts log from worker threads
+static std::mutex log_mutex;
 
 
 void dump_buffer_at_exit() {
@@ -53,6 +56,7 @@ void hlt::log::open(int bot_id) {
 
 void hlt::log::log(const std::string& message) {
     if (constants::IS_DEBUG) {
+        std::lock_guard<std::mutex> lock(log_mutex);
         if (has_opened) {
             log_file << message << std::endl;
         } else {
@@ -67,6 +71,7 @@ void hlt::log::log(const std::string& message) {
 
 void hlt::log::flog(const std::string& message) {
     if (constants::IS_DEBUG) {
+        std::lock_guard<std::mutex> lock(log_mutex);
         if (has_opened) {
             flog_file << message << std::endl;
         } else {
@@ -1,10 +1,10 @@
 #pragma once
 
-#include <cmath>
 #include "types.hpp"
 #include "position.hpp"
 #include "ship.hpp"
 #include "dropoff.hpp"
+#include "mining.hpp"
 
 namespace hlt {
     struct MapCell {
@@ -23,26 +23,26 @@ namespace hlt {
         }
 
         int cost() {
-            return halite / constants::MOVE_COST_RATIO;
+            return mining::move_cost(halite);
         }
 
         // Cost to move after n turns
         int cost(int turns) {
-            return remaining(turns) / constants::MOVE_COST_RATIO;
+            return mining::move_cost(remaining(turns));
         }
 
         // Remaining halite after n waits.
         int remaining(int turns) {
-            return ceil(halite * pow(1.0 - 1.0 / constants::EXTRACT_RATIO, turns));
+            return mining::remaining(halite, turns);
         }
 
         int gain() {
-            return halite / constants::EXTRACT_RATIO ;
+            return mining::gain(halite);
         }
 
         // Gain after n turns of pickups
         int gain(int turns) {
-            return remaining(turns) * pow(1.0 - constants::EXTRACT_RATIO, turns);
+            return mining::gained(halite, turns);
         }
 
         bool is_occupied(PlayerId p) const {
@@ -0,0 +1,50 @@
+#include "mining.hpp"
+#include "constants.hpp"
+
+namespace hlt {
+    namespace mining {
+        int EXTRACT[2][TABLE_HALITE];
+        int GAIN[2][TABLE_HALITE];
+        int MOVE_COST[TABLE_HALITE];
+        int REMAINING[2][TABLE_HALITE * (TABLE_TURNS + 1)];
+        int GAINED[2][TABLE_HALITE * (TABLE_TURNS + 1)];
+    }
+}
+
+using namespace hlt;
+
+int mining::extract_slow(int halite, bool inspired) {
+    int ratio = inspired ? constants::INSPIRED_EXTRACT_RATIO : constants::EXTRACT_RATIO;
+    return (halite + ratio - 1) / ratio;
+}
+
+int mining::gain_slow(int halite, bool inspired) {
+    int extracted = extract_slow(halite, inspired);
+    if (!inspired) return extracted;
+    return extracted + (int)(extracted * constants::INSPIRED_BONUS_MULTIPLIER);
+}
+
+int mining::move_cost_slow(int halite) {
+    return halite / constants::MOVE_COST_RATIO;
+}
+
+void mining::build_tables() {
+    for (int inspired = 0; inspired < 2; inspired++) {
+        for (int h = 0; h < TABLE_HALITE; h++) {
+            EXTRACT[inspired][h] = extract_slow(h, inspired);
+            GAIN[inspired][h] = gain_slow(h, inspired);
+
+            int left = h;
+            int total = 0;
+            for (int t = 0; t <= TABLE_TURNS; t++) {
+                REMAINING[inspired][h * (TABLE_TURNS + 1) + t] = left;
+                GAINED[inspired][h * (TABLE_TURNS + 1) + t] = total;
+                total += GAIN[inspired][left];
+                left -= EXTRACT[inspired][left];
+            }
+        }
+    }
+    for (int h = 0; h < TABLE_HALITE; h++) {
+        MOVE_COST[h] = move_cost_slow(h);
+    }
+}
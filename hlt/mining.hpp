@@ -0,0 +1,71 @@
+#pragma once
+
+namespace hlt {
+    // The engine's mining and movement arithmetic as integer lookup tables, built
+    // from the game constants by build_tables() right after populate_constants.
+    // Per turn the engine takes ceil(h / ratio) from a cell, pays an inspired ship
+    // that amount times the bonus multiplier on top, and charges floor(h / ratio)
+    // to move off it. Halite beyond TABLE_HALITE (stacked collision drops) or turns
+    // beyond TABLE_TURNS fall back to the same integer steps.
+    namespace mining {
+        const int TABLE_HALITE = 2048;
+        const int TABLE_TURNS = 16;
+
+        void build_tables();
+
+        // the tables, indexed [halite] or [halite * (TABLE_TURNS + 1) + turns]
+        extern int EXTRACT[2][TABLE_HALITE];
+        extern int GAIN[2][TABLE_HALITE];
+        extern int MOVE_COST[TABLE_HALITE];
+        extern int REMAINING[2][TABLE_HALITE * (TABLE_TURNS + 1)];
+        extern int GAINED[2][TABLE_HALITE * (TABLE_TURNS + 1)];
+
+        int extract_slow(int halite, bool inspired);
+        int gain_slow(int halite, bool inspired);
+        int move_cost_slow(int halite);
+
+        // Halite one turn of mining removes from a cell holding halite.
+        inline int extract(int halite, bool inspired = false) {
+            return halite < TABLE_HALITE ? EXTRACT[inspired][halite] : extract_slow(halite, inspired);
+        }
+
+        // Halite one turn of mining adds to the ship, inspiration bonus included.
+        inline int gain(int halite, bool inspired = false) {
+            return halite < TABLE_HALITE ? GAIN[inspired][halite] : gain_slow(halite, inspired);
+        }
+
+        // Just the inspiration bonus part of gain.
+        inline int inspired_bonus(int halite) {
+            return gain(halite, true) - extract(halite, true);
+        }
+
+        // Halite needed to move off a cell holding halite.
+        inline int move_cost(int halite) {
+            return halite < TABLE_HALITE ? MOVE_COST[halite] : move_cost_slow(halite);
+        }
+
+        // What is left on the cell after turns of mining.
+        inline int remaining(int halite, int turns, bool inspired = false) {
+            if (halite < TABLE_HALITE && turns <= TABLE_TURNS) {
+                return REMAINING[inspired][halite * (TABLE_TURNS + 1) + turns];
+            }
+            for (int t = 0; t < turns && halite > 0; t++) {
+                halite -= extract(halite, inspired);
+            }
+            return halite;
+        }
+
+        // Total the ship collects over turns of mining.
+        inline int gained(int halite, int turns, bool inspired = false) {
+            if (halite < TABLE_HALITE && turns <= TABLE_TURNS) {
+                return GAINED[inspired][halite * (TABLE_TURNS + 1) + turns];
+            }
+            int total = 0;
+            for (int t = 0; t < turns && halite > 0; t++) {
+                total += gain(halite, inspired);
+                halite -= extract(halite, inspired);
+            }
+            return total;
+        }
+    }
+}
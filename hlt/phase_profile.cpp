@@ -0,0 +1,41 @@
+#include "phase_profile.hpp"
+
+using namespace hlt;
+
+PhaseProfile::~PhaseProfile() {
+    if (file != nullptr) {
+        fclose(file);
+    }
+}
+
+bool PhaseProfile::open(const string &path) {
+    file = fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    fprintf(file, "turn,ships,phase,ms\n");
+    return true;
+}
+
+void PhaseProfile::start_turn(int turn, int ships) {
+    this->turn = turn;
+    this->ships = ships;
+    last = 0;
+}
+
+void PhaseProfile::add(const char *phase, double seconds) {
+    if (file == nullptr) return;
+    fprintf(file, "%d,%d,%s,%.4f\n", turn, ships, phase, seconds * 1000);
+}
+
+void PhaseProfile::mark(const char *phase, double elapsed) {
+    if (file == nullptr) return;
+    add(phase, elapsed - last);
+    last = elapsed;
+}
+
+void PhaseProfile::end_turn() {
+    if (file != nullptr) {
+        fflush(file);
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+using namespace std;
+namespace hlt {
+
+    // Where each turn's time goes, for benchmarks/turn_bench. MyBot --profile
+    // writes one CSV row per phase per turn:
+    //
+    //   turn,ships,phase,ms
+    //
+    // A phase runs from the previous mark of the turn (or its start) to its own
+    // mark, so a phase the turn skipped simply has no row.
+    class PhaseProfile {
+    public:
+        ~PhaseProfile();
+
+        bool open(const string &path);
+
+        bool is_open() const {
+            return file != nullptr;
+        }
+
+        void start_turn(int turn, int ships);
+
+        // Time already spent outside the turn timer, e.g. reading the frame.
+        void add(const char *phase, double seconds);
+
+        // elapsed is the turn timer's reading now, in seconds.
+        void mark(const char *phase, double elapsed);
+
+        void end_turn();
+
+    private:
+        FILE *file = nullptr;
+        int turn = 0;
+        int ships = 0;
+        double last = 0;
+    };
+}
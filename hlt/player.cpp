@@ -3,43 +3,78 @@
 
 void hlt::Player::_update(int num_ships, int num_dropoffs, Halite halite) {
     this->halite = halite;
+    frame_mark++;
 
-    map<EntityId, shared_ptr<Ship>> nextShips;
+    // known ships are updated where they are, only new ids get a ship
     for (int i = 0; i < num_ships; ++i) {
-        std::shared_ptr<hlt::Ship> ship = hlt::Ship::_generate(id);
-        if (ships.count(ship->id)) {
-            nextShips[ship->id] = ships[ship->id];
-            nextShips[ship->id]->_update(ship->halite, ship->position);
+        EntityId ship_id = hlt::get_int();
+        int x = hlt::get_int();
+        int y = hlt::get_int();
+        Halite ship_halite = hlt::get_int();
+
+        auto it = ships.find(ship_id);
+        if (it != ships.end()) {
+            it->second->_update(ship_halite, Position(x, y));
         }
         else {
-            nextShips[ship->id] = ship;
+            it = ships.emplace(ship_id, new_ship(ship_id, x, y, ship_halite)).first;
         }
+        it->second->seen = frame_mark;
 
-        if (nextShips[ship->id]->lifetime_hal > 1000) {
-            profitable_ships.insert(ship->id);
+        if (it->second->lifetime_hal > 1000) {
+            profitable_ships.insert(ship_id);
         }
     }
-    for (auto s : ships) {
-        if (!nextShips.count(s.second->id)) {
-            log::log("FOUND COLLISION");
-            this->collisions.insert(s.second->planned_next);
+    for (auto it = ships.begin(); it != ships.end();) {
+        if (it->second->seen == frame_mark) {
+            ++it;
+            continue;
         }
+        log::log("FOUND COLLISION");
+        this->collisions.insert(it->second->planned_next);
+        ship_pool.push_back(std::move(it->second));
+        it = ships.erase(it);
     }
-    ships = nextShips;
 
-    dropoffs.clear();
+    // anything the bot added itself (the fake dropoffs) goes again
     for (int i = 0; i < num_dropoffs; ++i) {
-        std::shared_ptr<hlt::Dropoff> dropoff = hlt::Dropoff::_generate(id);
-        dropoffs[dropoff->id] = dropoff;
+        EntityId dropoff_id = hlt::get_int();
+        int x = hlt::get_int();
+        int y = hlt::get_int();
+
+        auto it = dropoffs.find(dropoff_id);
+        if (it == dropoffs.end()) {
+            it = dropoffs.emplace(dropoff_id, std::make_shared<hlt::Dropoff>(id, dropoff_id, x, y)).first;
+        }
+        it->second->seen = frame_mark;
+    }
+    for (auto it = dropoffs.begin(); it != dropoffs.end();) {
+        if (it->second->seen == frame_mark) {
+            ++it;
+        }
+        else {
+            it = dropoffs.erase(it);
+        }
+    }
+}
+
+std::shared_ptr<hlt::Ship> hlt::Player::new_ship(EntityId ship_id, int x, int y, Halite ship_halite) {
+    for (auto &pooled : ship_pool) {
+        if (pooled.use_count() != 1) continue;
+        pooled->reset(id, ship_id, x, y, ship_halite);
+        std::shared_ptr<Ship> ship = std::move(pooled);
+        pooled = std::move(ship_pool.back());
+        ship_pool.pop_back();
+        return ship;
     }
+    return std::make_shared<hlt::Ship>(id, ship_id, x, y, ship_halite);
 }
 
 
 std::shared_ptr<hlt::Player> hlt::Player::_generate() {
-    PlayerId player_id;
-    int shipyard_x;
-    int shipyard_y;
-    hlt::get_sstream() >> player_id >> shipyard_x >> shipyard_y;
+    PlayerId player_id = hlt::get_int();
+    int shipyard_x = hlt::get_int();
+    int shipyard_y = hlt::get_int();
 
     return std::make_shared<hlt::Player>(player_id, shipyard_x, shipyard_y);
 }
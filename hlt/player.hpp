@@ -8,6 +8,7 @@
 #include <memory>
 #include <unordered_map>
 #include <set>
+#include <vector>
 
 namespace hlt {
     struct Player {
@@ -24,6 +25,11 @@ namespace hlt {
         std::map<EntityId, std::shared_ptr<Ship>> ships;
         std::map<EntityId, std::shared_ptr<Dropoff>> dropoffs;
 
+        // bumped every _update; ships and dropoffs not stamped with it are gone
+        int frame_mark = 0;
+        // dead ships, handed out again once nothing else holds them
+        std::vector<std::shared_ptr<Ship>> ship_pool;
+
         Player(PlayerId player_id, int shipyard_x, int shipyard_y) :
             id(player_id),
             shipyard(std::make_shared<Shipyard>(player_id, shipyard_x, shipyard_y)),
@@ -32,5 +38,8 @@ namespace hlt {
 
         void _update(int num_ships, int num_dropoffs, Halite halite);
         static std::shared_ptr<Player> _generate();
+
+    private:
+        std::shared_ptr<Ship> new_ship(EntityId ship_id, int x, int y, Halite ship_halite);
     };
 }
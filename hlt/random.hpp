@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+namespace hlt {
+
+    // xoshiro128++: small, fast and good enough for rollouts. Unlike rand() it
+    // holds no lock and every generator is its own reproducible stream, so each
+    // thread (or each ship's rollouts) gets one derived from the bot seed.
+    class Rng {
+    public:
+        explicit Rng(uint64_t seed = 0, uint64_t stream = 0) {
+            this->seed(seed, stream);
+        }
+
+        // Distinct (seed, stream) pairs give unrelated sequences.
+        void seed(uint64_t seed, uint64_t stream = 0) {
+            uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+            for (int i = 0; i < 4; i += 2) {
+                uint64_t z = splitmix64(x);
+                s[i] = (uint32_t)z;
+                s[i + 1] = (uint32_t)(z >> 32);
+            }
+            if ((s[0] | s[1] | s[2] | s[3]) == 0) s[0] = 1;
+        }
+
+        uint32_t next() {
+            uint32_t result = rotl(s[0] + s[3], 7) + s[0];
+            uint32_t t = s[1] << 9;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = rotl(s[3], 11);
+            return result;
+        }
+
+        // Uniform in [0, n), n > 0.
+        int below(int n) {
+            return (int)(((uint64_t)next() * (uint32_t)n) >> 32);
+        }
+
+        uint32_t operator()() {
+            return next();
+        }
+
+        // Raw state, so a sequence can be replayed or stepped in batch lanes.
+        void get_state(uint32_t out[4]) const {
+            for (int i = 0; i < 4; i++) out[i] = s[i];
+        }
+
+        void set_state(const uint32_t in[4]) {
+            for (int i = 0; i < 4; i++) s[i] = in[i];
+        }
+
+    private:
+        static uint32_t rotl(uint32_t x, int k) {
+            return (x << k) | (x >> (32 - k));
+        }
+
+        static uint64_t splitmix64(uint64_t &x) {
+            uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        uint32_t s[4];
+    };
+}
@@ -0,0 +1,62 @@
+#include "reservation_table.hpp"
+
+#include <algorithm>
+
+using namespace hlt;
+
+void ReservationTable::resize(int cells) {
+    this->cells = cells;
+    for (auto &l : layers) {
+        l.bits.assign((cells + 63) / 64, 0);
+        l.ships.clear();
+        l.generation = 0;
+    }
+}
+
+void ReservationTable::clear() {
+    generation++;
+}
+
+void ReservationTable::advance() {
+    // the old turn 0 wraps round to the far end of the window, empty
+    layers[base].generation = 0;
+    base = (base + 1) % HORIZON;
+}
+
+ReservationTable::Layer *ReservationTable::touch(int turn) {
+    if (turn < 0 || turn >= HORIZON) return nullptr;
+    Layer &l = layers[(base + turn) % HORIZON];
+    if (l.generation != generation) {
+        fill(l.bits.begin(), l.bits.end(), 0);
+        fill(l.ships.begin(), l.ships.end(), nullptr);
+        l.generation = generation;
+    }
+    return &l;
+}
+
+void ReservationTable::reserve(int turn, int cell, Ship *ship) {
+    Layer *l = touch(turn);
+    if (l == nullptr) return;
+    l->bits[cell >> 6] |= (uint64_t)1 << (cell & 63);
+    if (ship != nullptr && l->ships.empty()) {
+        l->ships.assign(cells, nullptr);
+    }
+    if (!l->ships.empty()) {
+        l->ships[cell] = ship;
+    }
+}
+
+void ReservationTable::release(int turn, int cell) {
+    Layer *l = touch(turn);
+    if (l == nullptr) return;
+    l->bits[cell >> 6] &= ~((uint64_t)1 << (cell & 63));
+    if (!l->ships.empty()) {
+        l->ships[cell] = nullptr;
+    }
+}
+
+Ship *ReservationTable::ship(int turn, int cell) const {
+    const Layer *l = peek(turn);
+    if (l == nullptr || l->ships.empty()) return nullptr;
+    return l->ships[cell];
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+namespace hlt {
+    struct Ship;
+
+    // Space-time reservations for the next HORIZON turns: one occupancy bitset per
+    // turn, plus (only for layers that ever got one) the ship holding each cell.
+    // Layers sit in a ring, so advance() moves every reservation one turn closer
+    // without copying, and clear() is a generation bump; a stale layer is wiped
+    // the next time something writes to it. Turns outside [0, HORIZON) are never
+    // reserved. Cells are y * width + x.
+    class ReservationTable {
+    public:
+        static const int HORIZON = 32;
+
+        void resize(int cells);
+
+        void clear();
+
+        // Turn 1 becomes turn 0; the old turn 0 is dropped.
+        void advance();
+
+        void reserve(int turn, int cell, Ship *ship = nullptr);
+
+        void release(int turn, int cell);
+
+        bool reserved(int turn, int cell) const {
+            const Layer *l = peek(turn);
+            return l != nullptr && (l->bits[cell >> 6] >> (cell & 63) & 1);
+        }
+
+        // nullptr if the cell is free or was reserved without a ship
+        Ship *ship(int turn, int cell) const;
+
+    private:
+        struct Layer {
+            uint64_t generation = 0;
+            vector<uint64_t> bits;
+            vector<Ship *> ships;
+        };
+
+        const Layer *peek(int turn) const {
+            if (turn < 0 || turn >= HORIZON) return nullptr;
+            const Layer &l = layers[(base + turn) % HORIZON];
+            return l.generation == generation ? &l : nullptr;
+        }
+
+        Layer *touch(int turn);
+
+        int cells = 0;
+        int base = 0;
+        uint64_t generation = 1;
+        Layer layers[HORIZON];
+    };
+}
@@ -0,0 +1,405 @@
+#include "rollout.hpp"
+#include "mining.hpp"
+#include "utils.hpp"
+
+using namespace hlt;
+
+// direction codes used inside the kernel
+static const int NORTH = 0, EAST = 1, SOUTH = 2, WEST = 3, STILL = 4, NONE = -1;
+static const int STEP_X[5] = {0, 1, 0, -1, 0};
+static const int STEP_Y[5] = {-1, 0, 1, 0, 0};
+static const Direction CODE_DIR[5] = {Direction::NORTH, Direction::EAST, Direction::SOUTH, Direction::WEST,
+                                      Direction::STILL};
+
+// check the clock every this many lockstep steps
+static const int TIME_CHECK_STEPS = 32;
+
+// The x and y moves get_unsafe_moves would offer from (x, y) towards (tx, ty), NONE if aligned.
+static inline void axis_moves(int x, int y, int tx, int ty, int width, int height, int &xm, int &ym) {
+    int dx = x < tx ? tx - x : x - tx;
+    int dy = y < ty ? ty - y : y - ty;
+    xm = x < tx ? (dx > width - dx ? WEST : EAST) : x > tx ? (dx < width - dx ? WEST : EAST) : NONE;
+    ym = y < ty ? (dy > height - dy ? NORTH : SOUTH) : y > ty ? (dy < height - dy ? NORTH : SOUTH) : NONE;
+}
+
+// The moves get_unsafe_moves would offer from (x, y) towards (tx, ty), followed
+// by STILL; the walk picks one uniformly. Returns the chosen direction code.
+static inline int pick_move(int x, int y, int tx, int ty, int width, int height, uint32_t r) {
+    int dx = x < tx ? tx - x : x - tx;
+    int dy = y < ty ? ty - y : y - ty;
+    int xm, ym;
+    axis_moves(x, y, tx, ty, width, height, xm, ym);
+
+    int count = (xm != NONE) + (ym != NONE);
+    int swap = (count == 2) & (dy > dx);
+    int m0 = swap ? ym : xm != NONE ? xm : ym;
+    int m1 = swap ? xm : ym;
+    // top 16 bits scaled to [0, count], 32 bit math so the lanes can share it
+    int k = (int)(((r >> 16) * (uint32_t)(count + 1)) >> 16);
+    return k < count ? (k == 0 ? m0 : m1) : STILL;
+}
+
+namespace {
+    // Four 32 bit lanes, one SSE2 register on the default x86-64 build (GCC and
+    // clang pick the closest thing elsewhere), so no -m flags are needed. The
+    // batch runs LANES / WIDTH of these side by side. Comparisons give -1 for
+    // true and 0 for false in each lane.
+    const int WIDTH = 4;
+    const int GROUPS = RolloutBatch::LANES / WIDTH;
+    typedef int32_t vint __attribute__((vector_size(4 * WIDTH)));
+    typedef uint32_t vuint __attribute__((vector_size(4 * WIDTH)));
+
+    inline vint splat(int v) {
+        return vint{} + v;
+    }
+
+    inline vuint rotl(vuint x, int k) {
+        return (x << k) | (x >> (32 - k));
+    }
+
+    inline vint select(vint mask, vint a, vint b) {
+        return (a & mask) | (b & ~mask);
+    }
+
+    inline vuint select(vint mask, vuint a, vuint b) {
+        return (a & (vuint)mask) | (b & ~(vuint)mask);
+    }
+
+    struct Lanes {
+        vint x[GROUPS], y[GROUPS], cell[GROUPS], square[GROUPS], cargo[GROUPS], turns[GROUPS], first[GROUPS],
+            active[GROUPS];
+        vuint s0[GROUPS], s1[GROUPS], s2[GROUPS], s3[GROUPS];
+        int index[RolloutBatch::LANES];
+        uint32_t seed[RolloutBatch::LANES][4];
+
+        // lane l is element l % WIDTH of group l / WIDTH
+        void start(int l, int rollout, int sx, int sy, int scell, int ssquare, int scargo) {
+            int g = l / WIDTH, i = l % WIDTH;
+            x[g][i] = sx;
+            y[g][i] = sy;
+            cell[g][i] = scell;
+            square[g][i] = ssquare;
+            cargo[g][i] = scargo;
+            turns[g][i] = 1;
+            first[g][i] = STILL;
+            active[g][i] = -1;
+            index[l] = rollout;
+            seed[l][0] = s0[g][i];
+            seed[l][1] = s1[g][i];
+            seed[l][2] = s2[g][i];
+            seed[l][3] = s3[g][i];
+        }
+    };
+}
+
+const Direction RolloutTally::MOVE_DIRS[RolloutTally::MOVES] = {Direction::NORTH, Direction::EAST,
+                                                                 Direction::SOUTH, Direction::WEST,
+                                                                 Direction::STILL};
+
+RolloutTally::RolloutTally(double floor_cost) : best_cost(floor_cost) {
+    for (int i = 0; i < MOVES; i++) {
+        move_cost[i] = -10;
+        move_seen[i] = false;
+    }
+}
+
+int RolloutTally::slot(Direction d) {
+    int m = 0;
+    while (MOVE_DIRS[m] != d) m++;
+    return m;
+}
+
+void RolloutTally::add(const RolloutEnd &end, double cost, int turns) {
+    int m = slot(end.first_move);
+    move_seen[m] = true;
+    move_cost[m] = fmax(move_cost[m], cost);
+    if (cost > best_cost || (cost == best_cost && has_best && end.index < best.index)) {
+        has_best = true;
+        best = end;
+        best_cost = cost;
+        best_turns = turns;
+    }
+}
+
+bool RolloutBatch::run(const RolloutGrid &grid, int start, int dest, int starting_halite, int count,
+                       Rng &rng, Timer *timer, double time_bank, RolloutTally &tally, const Direction *first) {
+    const int width = grid.width;
+    const int height = grid.height;
+    const int *halite = grid.halite.data();
+    const char *inspired = grid.inspired.data();
+    const int sx = start % width;
+    const int sy = start / width;
+
+    const vint tx = splat(dest % width), ty = splat(dest / width);
+    const vint w = splat(width), hgt = splat(height), dst = splat(dest);
+    const vint east = splat(EAST), west = splat(WEST), north = splat(NORTH), south = splat(SOUTH);
+    const vint still = splat(STILL), none = splat(NONE), zero = splat(0), one = splat(1);
+    const vint forced = splat(first != nullptr ? RolloutTally::slot(*first) : NONE);
+    const vint forcing = forced != none;
+
+    Lanes lanes;
+    int started = 0;
+    for (int l = 0; l < LANES; l++) {
+        int g = l / WIDTH, i = l % WIDTH;
+        uint32_t state[4];
+        Rng lane(((uint64_t)rng.next() << 32) | rng.next(), l);
+        lane.get_state(state);
+        lanes.s0[g][i] = state[0];
+        lanes.s1[g][i] = state[1];
+        lanes.s2[g][i] = state[2];
+        lanes.s3[g][i] = state[3];
+        lanes.active[g][i] = 0;
+        if (started < count) {
+            lanes.start(l, started++, sx, sy, start, halite[start], starting_halite);
+        }
+    }
+
+    bool out_of_time = false;
+    int running = started;
+    char finished[LANES] = {};
+    for (int step = 0; running > 0; step++) {
+        if (timer != nullptr && step % TIME_CHECK_STEPS == 0 && timer->elapsed() > time_bank) {
+            out_of_time = true;
+        }
+
+        for (int g = 0; g < GROUPS; g++) {
+            // xoshiro128++ on every lane at once
+            vuint a = lanes.s0[g], b = lanes.s1[g], c = lanes.s2[g], d = lanes.s3[g];
+            vuint r = rotl(a + d, 7) + a;
+            vuint t = b << 9;
+            c ^= a;
+            d ^= b;
+            b ^= c;
+            a ^= d;
+            c ^= t;
+            d = rotl(d, 11);
+
+            // pick_move, lane-wise
+            vint x = lanes.x[g], y = lanes.y[g], cell = lanes.cell[g], h = lanes.square[g], cargo = lanes.cargo[g];
+            vint dx = select(x < tx, tx - x, x - tx);
+            vint dy = select(y < ty, ty - y, y - ty);
+            vint xm = select(x < tx, select(dx > w - dx, west, east),
+                             select(x > tx, select(dx < w - dx, west, east), none));
+            vint ym = select(y < ty, select(dy > hgt - dy, north, south),
+                             select(y > ty, select(dy < hgt - dy, north, south), none));
+            vint has_x = xm != none, has_y = ym != none;
+            vint n = -(has_x + has_y);
+            vint swap = has_x & has_y & (dy > dx);
+            vint m0 = select(swap | ~has_x, ym, xm);
+            vint m1 = select(swap, xm, ym);
+            vint k = (vint)(((r >> 16) * (vuint)(n + 1)) >> 16);
+            vint move = select(k < n, select(k == zero, m0, m1), still);
+            move = select(forcing & (lanes.turns[g] == one), forced, move);
+
+            vint nx = x + (move == west) - (move == east);
+            vint ny = y + (move == north) - (move == south);
+            nx = select(nx < zero, nx + w, select(nx >= w, nx - w, nx));
+            ny = select(ny < zero, ny + hgt, select(ny >= hgt, ny - hgt, ny));
+            vint ncell = ny * w + nx;
+
+            // the only per-lane part: loads from the grid and the mining tables
+            vint next_square, taken, gain, cost;
+            for (int i = 0; i < WIDTH; i++) {
+                bool insp = inspired[cell[i]];
+                next_square[i] = halite[ncell[i]];
+                taken[i] = mining::extract(h[i], insp);
+                gain[i] = mining::gain(h[i], insp);
+                cost[i] = mining::move_cost(h[i]);
+            }
+
+            vint stay = (move == still) | (cargo < cost);
+
+            vint m = lanes.active[g];
+            vint moved = m & ~stay;
+            lanes.s0[g] = select(m, a, lanes.s0[g]);
+            lanes.s1[g] = select(m, b, lanes.s1[g]);
+            lanes.s2[g] = select(m, c, lanes.s2[g]);
+            lanes.s3[g] = select(m, d, lanes.s3[g]);
+            lanes.cargo[g] = select(m, select(stay, cargo + gain, cargo - cost), cargo);
+            lanes.square[g] = select(m, select(stay, h - taken, next_square), h);
+            lanes.x[g] = select(moved, nx, x);
+            lanes.y[g] = select(moved, ny, y);
+            lanes.cell[g] = select(moved, ncell, cell);
+            lanes.first[g] = select(m & (lanes.turns[g] == one), select(stay, still, move), lanes.first[g]);
+            lanes.turns[g] -= m;
+
+            vint done = m & ((lanes.cargo[g] >= splat(900)) | (lanes.cell[g] == dst));
+            for (int i = 0; i < WIDTH; i++) {
+                if (done[i]) finished[g * WIDTH + i] = 1;
+            }
+        }
+
+        for (int l = 0; l < LANES; l++) {
+            if (!finished[l]) continue;
+            finished[l] = 0;
+            int g = l / WIDTH, i = l % WIDTH;
+
+            RolloutEnd end;
+            end.cargo = lanes.cargo[g][i];
+            end.turns = lanes.turns[g][i];
+            end.end_cell = lanes.cell[g][i];
+            end.did_break = end.cargo >= 900;
+            end.first_move = CODE_DIR[lanes.first[g][i]];
+            end.index = lanes.index[l];
+            for (int j = 0; j < 4; j++) end.seed[j] = lanes.seed[l][j];
+            int turns;
+            double cost = rollout_score(grid, dest, starting_halite, end, turns);
+            tally.add(end, cost, turns);
+
+            lanes.active[g][i] = 0;
+            running--;
+            if (started < count && !out_of_time) {
+                lanes.start(l, started++, sx, sy, start, halite[start], starting_halite);
+                running++;
+            }
+        }
+    }
+    return !out_of_time;
+}
+
+bool RolloutBatch::run_adaptive(const RolloutGrid &grid, int start, int dest, int starting_halite, int count,
+                                Rng &rng, Timer *timer, double time_bank, RolloutTally &tally) {
+    // the arms: STILL, plus whichever moves the first step can afford
+    int arms[3];
+    int n = 0;
+    arms[n++] = STILL;
+    if (starting_halite >= mining::move_cost(grid.halite[start])) {
+        int xm, ym;
+        axis_moves(start % grid.width, start / grid.width, dest % grid.width, dest / grid.width, grid.width,
+                   grid.height, xm, ym);
+        if (xm != NONE) arms[n++] = xm;
+        if (ym != NONE) arms[n++] = ym;
+    }
+    if (n == 1) {
+        return run(grid, start, dest, starting_halite, count, rng, timer, time_bank, tally);
+    }
+
+    bool alive[3] = {true, true, true};
+    int alive_count = n;
+    int round = ARM_ROUND;
+    while (count > 0 && alive_count > 1) {
+        double before[3];
+        for (int a = 0; a < n; a++) {
+            before[a] = tally.move_seen[arms[a]] ? tally.move_cost[arms[a]] : -1e18;
+        }
+        for (int a = 0; a < n && count > 0; a++) {
+            if (!alive[a]) continue;
+            int walks = min(round, count);
+            count -= walks;
+            if (!run(grid, start, dest, starting_halite, walks, rng, timer, time_bank, tally, &CODE_DIR[arms[a]])) {
+                return false;
+            }
+        }
+
+        int leader = -1;
+        bool improved = false;
+        for (int a = 0; a < n; a++) {
+            if (!alive[a] || !tally.move_seen[arms[a]]) continue;
+            if (leader == -1 || tally.move_cost[arms[a]] > tally.move_cost[arms[leader]]) leader = a;
+            improved |= tally.move_cost[arms[a]] > before[a];
+        }
+        if (!improved) break;
+        for (int a = 0; a < n; a++) {
+            if (!alive[a] || a == leader) continue;
+            // a move that never finished a walk has no estimate yet, keep sampling it
+            if (tally.move_seen[arms[a]] && tally.move_cost[arms[a]] <= before[a]) {
+                alive[a] = false;
+                alive_count--;
+            }
+        }
+        round *= 2;
+    }
+    return true;
+}
+
+RolloutEnd hlt::rollout_walk(const RolloutGrid &grid, int start, int dest, int starting_halite, Rng &rng,
+                             vector<Position> *path, const Direction *first) {
+    const int width = grid.width;
+    const int height = grid.height;
+    const int tx = dest % width;
+    const int ty = dest / width;
+
+    RolloutEnd end;
+    rng.get_state(end.seed);
+    end.index = 0;
+    end.did_break = false;
+    end.first_move = Direction::STILL;
+
+    int x = start % width;
+    int y = start / width;
+    int cell = start;
+    int h = grid.halite[cell];
+    int cargo = starting_halite;
+    int turns = 1;
+    while (cell != dest) {
+        if (path != nullptr) path->push_back(Position(x, y));
+
+        int move = pick_move(x, y, tx, ty, width, height, rng.next());
+        if (first != nullptr && turns == 1) {
+            move = RolloutTally::slot(*first);
+        }
+        if (move == STILL || cargo < mining::move_cost(h)) {
+            move = STILL;
+            cargo += mining::gain(h, grid.inspired[cell]);
+            h -= mining::extract(h, grid.inspired[cell]);
+        }
+        else {
+            cargo -= mining::move_cost(h);
+            x = (x + STEP_X[move] + width) % width;
+            y = (y + STEP_Y[move] + height) % height;
+            cell = y * width + x;
+            h = grid.halite[cell];
+        }
+        if (turns == 1) {
+            end.first_move = CODE_DIR[move];
+        }
+        turns++;
+        if (cargo >= 900) {
+            end.did_break = true;
+            break;
+        }
+    }
+
+    end.cargo = cargo;
+    end.turns = turns;
+    end.end_cell = cell;
+    return end;
+}
+
+void hlt::rollout_box(const RolloutGrid &grid, int start, int dest, vector<int> &cells) {
+    int x = start % grid.width, y = start / grid.width;
+    int tx = dest % grid.width, ty = dest / grid.width;
+    int xm, ym;
+    axis_moves(x, y, tx, ty, grid.width, grid.height, xm, ym);
+    int step_x = xm == NONE ? 0 : STEP_X[xm];
+    int step_y = ym == NONE ? 0 : STEP_Y[ym];
+    int size_x = ((tx - x) * step_x + grid.width) % grid.width;
+    int size_y = ((ty - y) * step_y + grid.height) % grid.height;
+    for (int i = 0; i <= size_x; i++) {
+        for (int j = 0; j <= size_y; j++) {
+            int cx = (x + i * step_x + grid.width) % grid.width;
+            int cy = (y + j * step_y + grid.height) % grid.height;
+            cells.push_back(cy * grid.width + cx);
+        }
+    }
+}
+
+double hlt::rollout_score(const RolloutGrid &grid, int dest, int starting_halite, const RolloutEnd &end,
+                          int &turns_out) {
+    int curr_halite = end.cargo + grid.enemy_cargo[end.end_cell];
+    bool inspired = grid.inspired[dest];
+
+    int turns = end.turns + 1;
+    if (end.did_break) {
+        turns_out = turns - 1;
+        return (curr_halite - starting_halite) / (double)turns_out;
+    }
+
+    double c = (mining::gained(grid.halite[dest], 1, inspired) + curr_halite - starting_halite) / (double)turns;
+    for (int i = 1; i <= 6; i++) {
+        int dest_halite = mining::gained(grid.halite[dest], i + 1, inspired);
+        c = fmax(c, (dest_halite + curr_halite - starting_halite) / (double)(turns + i));
+    }
+    turns_out = turns;
+    return c;
+}
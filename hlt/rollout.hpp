@@ -0,0 +1,106 @@
+#pragma once
+
+#include "direction.hpp"
+#include "random.hpp"
+#include "types.hpp"
+
+#include <cstdint>
+#include <vector>
+
+struct Timer;
+
+using namespace std;
+namespace hlt {
+
+    // Flat read only copy of what the gather rollouts look at, filled once per turn
+    // by GameMap::prepare_rollouts(). Cells are indexed y * width + x.
+    struct RolloutGrid {
+        int width = 0;
+        int height = 0;
+        vector<int> halite;
+        vector<char> inspired;
+        // halite carried by an enemy ship on the cell, 0 if there is none
+        vector<int> enemy_cargo;
+
+        bool empty() const {
+            return halite.empty();
+        }
+    };
+
+    // How one random walk ended, before scoring.
+    struct RolloutEnd {
+        int cargo;
+        int turns;
+        int end_cell;
+        bool did_break;
+        Direction first_move;
+        int index;
+        // rng state when the walk started, enough to replay it
+        uint32_t seed[4];
+    };
+
+    // Running result of a batch, in fixed storage so scoring a walk never
+    // allocates: the best score per first move and the best walk overall.
+    struct RolloutTally {
+        // N, E, S, W, STILL, the same order as the batch's direction codes
+        static const int MOVES = 5;
+        static const Direction MOVE_DIRS[MOVES];
+
+        double move_cost[MOVES];
+        bool move_seen[MOVES];
+        bool has_best = false;
+        RolloutEnd best;
+        double best_cost;
+        int best_turns = 1;
+
+        explicit RolloutTally(double floor_cost);
+
+        static int slot(Direction d);
+
+        // Ties go to the walk started first, whatever order the lanes finish in.
+        void add(const RolloutEnd &end, double cost, int turns);
+    };
+
+    // Random monotone walks from start to dest, mining whenever the walk stays
+    // still or cannot afford to move. LANES walks advance in lockstep in vector
+    // registers, each step masked per lane, and a lane that finishes is refilled
+    // with the next walk until count walks have started or the time bank runs out.
+    class RolloutBatch {
+    public:
+        static const int LANES = 8;
+
+        // Walks per first move in the first round of run_adaptive; later rounds double.
+        static const int ARM_ROUND = 128;
+
+        // Scores every finished walk with rollout_score into tally. Each lane draws
+        // from its own stream seeded from rng. If first is given every walk opens
+        // with that move (it must be one the walk could pick). Returns false if
+        // the time bank cut it short.
+        bool run(const RolloutGrid &grid, int start_cell, int dest_cell, int starting_halite, int count,
+                 Rng &rng, Timer *timer, double time_bank, RolloutTally &tally,
+                 const Direction *first = nullptr);
+
+        // Same budget, spent by successive halving over the possible first moves:
+        // rounds of forced-first-move walks, doubling in size, where a move whose
+        // best score stopped improving while another leads gets no more walks.
+        // Stops early once a round improves no move.
+        bool run_adaptive(const RolloutGrid &grid, int start_cell, int dest_cell, int starting_halite,
+                          int count, Rng &rng, Timer *timer, double time_bank, RolloutTally &tally);
+    };
+
+    // The single walk the batch lanes replicate, one step at a time. Used to replay
+    // the winning walk from its seed; path, if given, gets every cell the walk
+    // stood on before dest (end.turns - 1 of them, so reserve that many to keep it
+    // allocation free). first forces the opening move as in RolloutBatch::run.
+    RolloutEnd rollout_walk(const RolloutGrid &grid, int start_cell, int dest_cell, int starting_halite,
+                            Rng &rng, vector<Position> *path, const Direction *first = nullptr);
+
+    // Appends the cells of the box a monotone walk from start to dest stays in.
+    // Apart from enemy cargo that is everything the walk and its score read.
+    void rollout_box(const RolloutGrid &grid, int start_cell, int dest_cell, vector<int> &cells);
+
+    // Halite per turn estimate of a finished walk: what it carries, plus mining
+    // dest for up to six more turns. turns gets the turn count of the estimate.
+    double rollout_score(const RolloutGrid &grid, int dest_cell, int starting_halite, const RolloutEnd &end,
+                         int &turns);
+}
@@ -0,0 +1,76 @@
+#include "rollout_cache.hpp"
+
+#include <cstdlib>
+
+using namespace hlt;
+
+const int RolloutCache::TOP_UP_WALKS;
+
+uint64_t RolloutCache::key(int start, int dest, int cargo) {
+    return ((uint64_t)start << 40) | ((uint64_t)dest << 16) | (uint64_t)(cargo / CARGO_BUCKET);
+}
+
+bool RolloutCache::valid(const RolloutGrid &grid, const Slot &slot) const {
+    for (size_t i = 0; i < slot.cells.size(); i++) {
+        int c = slot.cells[i];
+        if (abs(grid.halite[c] - slot.halite[i]) > CHANGE_THRESHOLD) return false;
+        if (grid.inspired[c] != slot.inspired[i]) return false;
+    }
+    return true;
+}
+
+bool RolloutCache::lookup(const RolloutGrid &grid, int start, int dest, int cargo, Entry &out) {
+    lock_guard<mutex> guard(lock);
+    auto it = slots.find(key(start, dest, cargo));
+    if (it == slots.end() || !valid(grid, it->second)) {
+        misses++;
+        return false;
+    }
+    hits++;
+    it->second.last_used = turn;
+    out = it->second.entry;
+    return true;
+}
+
+bool RolloutCache::has(const RolloutGrid &grid, int start, int dest, int cargo) {
+    lock_guard<mutex> guard(lock);
+    auto it = slots.find(key(start, dest, cargo));
+    return it != slots.end() && valid(grid, it->second);
+}
+
+void RolloutCache::store(const RolloutGrid &grid, int start, int dest, int cargo, const Entry &entry) {
+    Slot slot;
+    slot.entry = entry;
+    slot.last_used = turn;
+    rollout_box(grid, start, dest, slot.cells);
+    for (int c : slot.cells) {
+        slot.halite.push_back(grid.halite[c]);
+        slot.inspired.push_back(grid.inspired[c]);
+    }
+
+    lock_guard<mutex> guard(lock);
+    slots[key(start, dest, cargo)] = move(slot);
+}
+
+void RolloutCache::refresh(int start, int dest, int cargo, const RolloutTally &tally) {
+    lock_guard<mutex> guard(lock);
+    auto it = slots.find(key(start, dest, cargo));
+    if (it != slots.end()) {
+        it->second.entry.tally = tally;
+    }
+}
+
+void RolloutCache::next_turn() {
+    lock_guard<mutex> guard(lock);
+    for (auto it = slots.begin(); it != slots.end();) {
+        if (it->second.last_used < turn) {
+            it = slots.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    turn++;
+    hits = 0;
+    misses = 0;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "rollout.hpp"
+#include "types.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+namespace hlt {
+
+    // get_best_random_walk results carried over from earlier turns, keyed by
+    // (start, dest, cargo bucket). An entry keeps the halite and inspiration of
+    // every cell in its start/dest box as they were when it was computed, and
+    // only counts as a hit while no box cell has moved more than
+    // CHANGE_THRESHOLD halite or flipped inspiration since. Enemy cargo is not
+    // part of the check. Safe to use from the rollout workers.
+    class RolloutCache {
+    public:
+        static const int CARGO_BUCKET = 32;
+        static const int CHANGE_THRESHOLD = 16;
+        // walks a rollout entry gets on top of its cached tally each turn it is reused
+        static const int TOP_UP_WALKS = 256;
+
+        struct Entry {
+            bool exact = false;
+            RolloutTally tally = RolloutTally(0);
+            // only kept for exact entries, sampled ones replay their best seed
+            vector<Position> path;
+        };
+
+        // True and fills out if a still valid entry exists.
+        bool lookup(const RolloutGrid &grid, int start_cell, int dest_cell, int cargo, Entry &out);
+
+        // Same check without copying the entry.
+        bool has(const RolloutGrid &grid, int start_cell, int dest_cell, int cargo);
+
+        // New result computed on grid as it is now.
+        void store(const RolloutGrid &grid, int start_cell, int dest_cell, int cargo, const Entry &entry);
+
+        // Topped up result; keeps the snapshot it was first computed on so drift
+        // over several turns still invalidates it.
+        void refresh(int start_cell, int dest_cell, int cargo, const RolloutTally &tally);
+
+        // Call once per turn; drops entries nobody asked for last turn.
+        void next_turn();
+
+        int hits = 0;
+        int misses = 0;
+
+    private:
+        struct Slot {
+            Entry entry;
+            vector<int> cells;
+            vector<int> halite;
+            vector<char> inspired;
+            int last_used = 0;
+        };
+
+        static uint64_t key(int start_cell, int dest_cell, int cargo);
+        bool valid(const RolloutGrid &grid, const Slot &slot) const;
+
+        mutex lock;
+        unordered_map<uint64_t, Slot> slots;
+        int turn = 0;
+    };
+}
@@ -1,5 +1,4 @@
 #include "ship.hpp"
-#include "input.hpp"
 #include "direction.hpp"
 #include "game_map.hpp"
 #include "game.hpp"
@@ -7,18 +6,8 @@
 
 using namespace hlt;
 
-std::shared_ptr<hlt::Ship> hlt::Ship::_generate(hlt::PlayerId player_id) {
-    hlt::EntityId ship_id;
-    int x;
-    int y;
-    hlt::Halite halite;
-    hlt::get_sstream() >> ship_id >> x >> y >> halite;
-
-    return std::make_shared<hlt::Ship>(player_id, ship_id, x, y, halite);
-}
-
-vector<Direction> Ship::GetBannedDirs(GameMap *game_map, EnemyResponse type, Game& g) {
-    auto dirs = GetAllowedDirs(game_map, type, g);
+vector<Direction> Ship::GetBannedDirs(GameMap *game_map, EnemyResponse type, Game& g, Rng &rng) {
+    auto dirs = GetAllowedDirs(game_map, type, g, rng);
 
     vector<Direction> out;
     for (auto dir : ALL_DIRS) {
@@ -37,7 +26,7 @@ vector<Direction> Ship::GetBannedDirs(GameMap *game_map, EnemyResponse type, Gam
 }
 
 // TODO... should weight squares by how bad they are.. e.g. should prefer walking into opponent with 300 than 3
-vector<Direction> Ship::GetAllowedDirs(GameMap *game_map, EnemyResponse type, Game &g) {
+vector<Direction> Ship::GetAllowedDirs(GameMap *game_map, EnemyResponse type, Game &g, Rng &rng) {
     // Check if we can move
     if (halite < game_map->at(this)->cost()) {
         return vector<Direction>(1, Direction::STILL);
@@ -96,7 +85,7 @@ vector<Direction> Ship::GetAllowedDirs(GameMap *game_map, EnemyResponse type, Ga
         }
         else {
             if (stuck) {
-                if (rand() % 8 == 0) {
+                if (rng.below(8) == 0) {
                     out.push_back(d);
                 }
             }
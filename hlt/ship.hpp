@@ -3,6 +3,7 @@
 #include "entity.hpp"
 #include "constants.hpp"
 #include "command.hpp"
+#include "random.hpp"
 
 #include <memory>
 #include <set>
@@ -15,7 +16,7 @@ namespace hlt {
 
     struct Ship : Entity {
         Halite halite;
-        ShipState state;
+        ShipState state = GATHERING;
 
         int last_hal = 0;
         int lifetime_hal = 0;
@@ -29,8 +30,22 @@ namespace hlt {
             halite(halite)
         {}
 
-        vector<Direction> GetBannedDirs(GameMap *game_map, EnemyResponse type, Game& g);
-        vector<Direction> GetAllowedDirs(GameMap *game_map, EnemyResponse type, Game &g);
+        // Turns a pooled ship into a new one, keeping history's buffer.
+        void reset(PlayerId player_id, EntityId ship_id, int x, int y, Halite ship_halite) {
+            owner = player_id;
+            id = ship_id;
+            position = Position(x, y);
+            seen = 0;
+            halite = ship_halite;
+            state = GATHERING;
+            last_hal = 0;
+            lifetime_hal = 0;
+            planned_next = Position();
+            history.clear();
+        }
+
+        vector<Direction> GetBannedDirs(GameMap *game_map, EnemyResponse type, Game& g, Rng &rng);
+        vector<Direction> GetAllowedDirs(GameMap *game_map, EnemyResponse type, Game &g, Rng &rng);
 
         bool is_full() const {
             return halite >= constants::MAX_HALITE;
@@ -52,8 +67,6 @@ namespace hlt {
             log::log("Ship #" + std::to_string(id) + ": " + s);
         }
 
-        static std::shared_ptr<Ship> _generate(PlayerId player_id);
-
         bool is_stuck() {
             if (history.size() < 8) return false;
             if (halite - last_hal > 50) {
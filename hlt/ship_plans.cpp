@@ -0,0 +1,118 @@
+#include "ship_plans.hpp"
+#include "mining.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace hlt;
+
+// Same cell or one step apart, wrapping around the map edges.
+static bool adjacent(const RolloutGrid &grid, int a, int b) {
+    int dx = abs(a % grid.width - b % grid.width);
+    int dy = abs(a / grid.width - b / grid.width);
+    dx = min(dx, grid.width - dx);
+    dy = min(dy, grid.height - dy);
+    return dx + dy <= 1;
+}
+
+int ShipPlans::predict(const RolloutGrid &grid, const Plan &plan, int cargo) {
+    int c = plan.cells[0];
+    if (plan.cells[1] == c) {
+        return cargo + mining::gain(grid.halite[c], grid.inspired[c]);
+    }
+    return cargo - mining::move_cost(grid.halite[c]);
+}
+
+bool ShipPlans::valid(const RolloutGrid &grid, const Plan &plan, EntityId id, int start_cell, int dest_cell,
+                      int cargo) const {
+    if ((turn + id) % IMPROVE_EVERY == 0) return false;
+    if (plan.dest != dest_cell || plan.cells.size() < 3 || plan.cells[1] != start_cell) return false;
+    if (abs(cargo - plan.cargo) > CARGO_SLACK) return false;
+    for (size_t i = 2; i < plan.cells.size(); i++) {
+        int c = plan.cells[i];
+        // the ship's own mining is already part of the plan
+        if (c == plan.cells[0] || c == start_cell) continue;
+        if (abs(grid.halite[c] - plan.halite[i]) > CHANGE_THRESHOLD) return false;
+        if (grid.inspired[c] != plan.inspired[i]) return false;
+    }
+    return true;
+}
+
+bool ShipPlans::follow(const RolloutGrid &grid, EntityId id, int start_cell, int dest_cell, int cargo, Step &step) {
+    lock_guard<mutex> guard(lock);
+    auto it = plans.find(id);
+    if (it == plans.end() || !valid(grid, it->second, id, start_cell, dest_cell, cargo)) {
+        replanned++;
+        return false;
+    }
+    followed++;
+
+    Plan &plan = it->second;
+    plan.cells.erase(plan.cells.begin());
+    plan.halite.erase(plan.halite.begin());
+    plan.inspired.erase(plan.inspired.begin());
+    plan.cargo = predict(grid, plan, cargo);
+    plan.turns = max(1, plan.turns - 1);
+    plan.last_used = turn;
+
+    step.next_cell = plan.cells[1];
+    step.value = plan.value;
+    step.turns = plan.turns;
+    step.priority = plan.priority;
+    step.path.clear();
+    for (int c : plan.cells) {
+        step.path.push_back(Position(c % grid.width, c / grid.width));
+    }
+    return true;
+}
+
+bool ShipPlans::holds(const RolloutGrid &grid, EntityId id, int start_cell, int dest_cell, int cargo) {
+    lock_guard<mutex> guard(lock);
+    auto it = plans.find(id);
+    return it != plans.end() && valid(grid, it->second, id, start_cell, dest_cell, cargo);
+}
+
+void ShipPlans::store(const RolloutGrid &grid, EntityId id, int dest_cell, int cargo, const vector<Position> &path,
+                      int end_cell, double value, int turns,
+                      const array<double, RolloutTally::MOVES> &priority) {
+    Plan plan;
+    plan.dest = dest_cell;
+    for (auto &p : path) {
+        plan.cells.push_back(p.y * grid.width + p.x);
+    }
+    if (plan.cells.empty() || plan.cells.back() != end_cell) {
+        plan.cells.push_back(end_cell);
+    }
+    // follow() steps along the cells one move at a time, a walk that does not
+    // is not worth keeping
+    for (size_t i = 1; i < plan.cells.size(); i++) {
+        if (!adjacent(grid, plan.cells[i - 1], plan.cells[i])) return;
+    }
+    for (int c : plan.cells) {
+        plan.halite.push_back(grid.halite[c]);
+        plan.inspired.push_back(grid.inspired[c]);
+    }
+    plan.cargo = plan.cells.size() > 1 ? predict(grid, plan, cargo) : cargo;
+    plan.value = value;
+    plan.turns = turns;
+    plan.priority = priority;
+    plan.last_used = turn;
+
+    lock_guard<mutex> guard(lock);
+    plans[id] = move(plan);
+}
+
+void ShipPlans::next_turn() {
+    lock_guard<mutex> guard(lock);
+    for (auto it = plans.begin(); it != plans.end();) {
+        if (it->second.last_used < turn) {
+            it = plans.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    turn++;
+    followed = 0;
+    replanned = 0;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "rollout.hpp"
+#include "types.hpp"
+
+#include <array>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+namespace hlt {
+
+    // The walk get_best_random_walk picked for each ship, carried from turn to
+    // turn so a ship that is still on it just takes its next step instead of
+    // searching again. A plan holds while:
+    // - the ship is where the plan put it, with about the cargo it predicted,
+    //   and still has the same destination;
+    // - no cell it has yet to visit moved more than CHANGE_THRESHOLD halite or
+    //   flipped inspiration since the plan was made (this is how the other
+    //   ships' moves reach it);
+    // - it is not the ship's turn for a fresh search, which comes every
+    //   IMPROVE_EVERY turns, staggered by ship id.
+    // Safe to use from the rollout workers.
+    class ShipPlans {
+    public:
+        static const int IMPROVE_EVERY = 6;
+        static const int CARGO_SLACK = 16;
+        static const int CHANGE_THRESHOLD = 16;
+
+        struct Step {
+            int next_cell;
+            double value;
+            int turns;
+            vector<Position> path;
+            array<double, RolloutTally::MOVES> priority;
+        };
+
+        // True if the ship's plan still holds; step gets its next cell and the
+        // rest of the walk, and the plan moves on by one turn.
+        bool follow(const RolloutGrid &grid, EntityId id, int start_cell, int dest_cell, int cargo, Step &step);
+
+        // Same check, nothing changes.
+        bool holds(const RolloutGrid &grid, EntityId id, int start_cell, int dest_cell, int cargo);
+
+        // New plan made on grid as it is now. path starts at the ship's cell, one
+        // entry per turn; end_cell is where the walk finishes. priority is what
+        // the tally the walk came from gave each first move, 0 where nothing was
+        // sampled. A path that skips a cell is not stored.
+        void store(const RolloutGrid &grid, EntityId id, int dest_cell, int cargo, const vector<Position> &path,
+                   int end_cell, double value, int turns, const array<double, RolloutTally::MOVES> &priority);
+
+        // Call once per turn; drops plans of ships that were not seen last turn.
+        void next_turn();
+
+        int followed = 0;
+        int replanned = 0;
+
+    private:
+        struct Plan {
+            int dest;
+            // cells[0] is the ship's cell on the turn the plan was last advanced
+            vector<int> cells;
+            vector<int> halite;
+            vector<char> inspired;
+            int cargo;
+            double value;
+            int turns;
+            array<double, RolloutTally::MOVES> priority;
+            int last_used;
+        };
+
+        static int predict(const RolloutGrid &grid, const Plan &plan, int cargo);
+        bool valid(const RolloutGrid &grid, const Plan &plan, EntityId id, int start_cell, int dest_cell, int cargo) const;
+
+        mutex lock;
+        unordered_map<EntityId, Plan> plans;
+        int turn = 0;
+    };
+}
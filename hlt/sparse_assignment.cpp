@@ -0,0 +1,380 @@
+#include "sparse_assignment.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+using namespace hlt;
+
+static const double INF = std::numeric_limits<double>::infinity();
+
+constexpr double SparseAssignment::EXACT_SHARE;
+
+void SparseAssignment::reset(int cols) {
+    this->cols = cols;
+    row_start.assign(1, 0);
+    edge_col.clear();
+    edge_cost.clear();
+}
+
+void SparseAssignment::add_edge(int col, double cost) {
+    edge_col.push_back(col);
+    edge_cost.push_back(cost);
+}
+
+void SparseAssignment::end_row() {
+    row_start.push_back((int)edge_col.size());
+}
+
+double SparseAssignment::solve(vector<int> &assignment) {
+    run(nullptr, 0);
+
+    int n = rows();
+    double cost = 0;
+    assignment.assign(n, -1);
+    for (int r = 0; r < n; r++) {
+        assignment[r] = row_match[r];
+        if (row_match[r] != -1) cost += edge_cost_of(r, row_match[r]);
+    }
+    return cost;
+}
+
+bool SparseAssignment::run(Timer *timer, double deadline) {
+    int n = rows();
+
+    u.assign(n, 0);
+    v.assign(cols, 0);
+    row_match.assign(n, -1);
+    col_match.assign(cols, -1);
+    dist.assign(cols, INF);
+    pred.assign(cols, -1);
+    done.assign(cols, 0);
+
+    // Row reduction, then a cheap pass matching rows onto free tight columns. Most
+    // ships want different squares so this settles the bulk of the rows.
+    for (int r = 0; r < n; r++) {
+        double m = INF;
+        for (int e = row_start[r]; e < row_start[r + 1]; e++) {
+            m = min(m, edge_cost[e]);
+        }
+        u[r] = row_start[r] == row_start[r + 1] ? 0 : m;
+        for (int e = row_start[r]; e < row_start[r + 1]; e++) {
+            int c = edge_col[e];
+            if (col_match[c] == -1 && edge_cost[e] == u[r]) {
+                col_match[c] = r;
+                row_match[r] = c;
+                break;
+            }
+        }
+    }
+
+    for (int r = 0; r < n; r++) {
+        if (row_match[r] == -1) {
+            if (timer != nullptr && timer->elapsed() > deadline) {
+                return false;
+            }
+            augment(r);
+        }
+    }
+    return true;
+}
+
+double SparseAssignment::edge_cost_of(int row, int col) {
+    for (int e = row_start[row]; e < row_start[row + 1]; e++) {
+        if (edge_col[e] == col) return edge_cost[e];
+    }
+    return INF;
+}
+
+// Dijkstra over reduced costs from a free row until it reaches a free column,
+// then flips the alternating path and updates the potentials.
+bool SparseAssignment::augment(int root) {
+    auto cmp = std::greater<pair<double, int>>();
+    heap.clear();
+    touched.clear();
+    finalized.clear();
+
+    for (int e = row_start[root]; e < row_start[root + 1]; e++) {
+        int c = edge_col[e];
+        double d = edge_cost[e] - u[root] - v[c];
+        if (d < dist[c]) {
+            if (dist[c] == INF) touched.push_back(c);
+            dist[c] = d;
+            pred[c] = root;
+            heap.push_back({d, c});
+            push_heap(heap.begin(), heap.end(), cmp);
+        }
+    }
+
+    int free_col = -1;
+    double D = 0;
+    while (!heap.empty()) {
+        pop_heap(heap.begin(), heap.end(), cmp);
+        auto top = heap.back();
+        heap.pop_back();
+        int j = top.second;
+        if (done[j] || top.first > dist[j]) continue;
+        done[j] = 1;
+        finalized.push_back(j);
+
+        if (col_match[j] == -1) {
+            free_col = j;
+            D = top.first;
+            break;
+        }
+
+        int i = col_match[j];
+        for (int e = row_start[i]; e < row_start[i + 1]; e++) {
+            int c = edge_col[e];
+            if (done[c]) continue;
+            double d = top.first + edge_cost[e] - u[i] - v[c];
+            if (d < dist[c]) {
+                if (dist[c] == INF) touched.push_back(c);
+                dist[c] = d;
+                pred[c] = i;
+                heap.push_back({d, c});
+                push_heap(heap.begin(), heap.end(), cmp);
+            }
+        }
+    }
+
+    if (free_col != -1) {
+        for (int j : finalized) {
+            double delta = D - dist[j];
+            v[j] -= delta;
+            if (col_match[j] != -1) {
+                u[col_match[j]] += delta;
+            }
+        }
+        u[root] += D;
+
+        int j = free_col;
+        while (j != -1) {
+            int i = pred[j];
+            int next = row_match[i];
+            row_match[i] = j;
+            col_match[j] = i;
+            j = i == root ? -1 : next;
+        }
+    }
+
+    for (int c : touched) {
+        dist[c] = INF;
+        pred[c] = -1;
+        done[c] = 0;
+    }
+    return free_col != -1;
+}
+
+void SparseAssignment::build_slots(const vector<vector<pair<double, Position>>> &candidates) {
+    // A position gets as many slots as the most times any single row lists it.
+    // Every row that lists the position may take any of its slots.
+    int key_height = 0;
+    key_width = 0;
+    for (auto &row : candidates) {
+        for (auto &c : row) {
+            key_width = max(key_width, c.second.x + 1);
+            key_height = max(key_height, c.second.y + 1);
+        }
+    }
+    size_t keys = (size_t)key_width * key_height;
+    if (slot_count.size() < keys) {
+        first_slot.resize(keys, 0);
+        slot_count.resize(keys, 0);
+        row_uses.resize(keys, 0);
+    }
+    auto key = [this](const Position &p) { return p.y * key_width + p.x; };
+
+    slot_pos.clear();
+    cell_keys.clear();
+    for (auto &row : candidates) {
+        for (auto &c : row) {
+            int cell = key(c.second);
+            int k = ++row_uses[cell];
+            if (slot_count[cell] == 0) cell_keys.push_back(cell);
+            slot_count[cell] = max(slot_count[cell], k);
+        }
+        for (auto &c : row) {
+            row_uses[key(c.second)] = 0;
+        }
+    }
+    for (int cell : cell_keys) {
+        first_slot[cell] = (int)slot_pos.size();
+        slot_pos.insert(slot_pos.end(), slot_count[cell], Position(cell % key_width, cell / key_width));
+    }
+
+    reset((int)slot_pos.size());
+    for (auto &row : candidates) {
+        for (auto &c : row) {
+            int cell = key(c.second);
+            if (row_uses[cell]++) continue;
+            int first = first_slot[cell];
+            for (int s = first; s < first + slot_count[cell]; s++) {
+                add_edge(s, c.first);
+            }
+        }
+        for (auto &c : row) {
+            row_uses[key(c.second)] = 0;
+        }
+        end_row();
+    }
+    for (int cell : cell_keys) {
+        slot_count[cell] = 0;
+    }
+}
+
+double SparseAssignment::solve(const vector<vector<pair<double, Position>>> &candidates, vector<Position> &assignment) {
+    build_slots(candidates);
+
+    vector<int> slots;
+    double cost = solve(slots);
+
+    assignment.assign(slots.size(), Position{-1, -1});
+    for (int r = 0; r < (int)slots.size(); r++) {
+        if (slots[r] != -1) {
+            assignment[r] = slot_pos[slots[r]];
+        }
+    }
+    return cost;
+}
+
+double SparseAssignment::finish(const vector<int> &slots, vector<Position> &assignment) {
+    double cost = 0;
+    assignment.assign(slots.size(), Position{-1, -1});
+    for (int r = 0; r < (int)slots.size(); r++) {
+        if (slots[r] != -1) {
+            assignment[r] = slot_pos[slots[r]];
+            cost += edge_cost_of(r, slots[r]);
+        }
+    }
+    return cost;
+}
+
+double SparseAssignment::solve(const vector<vector<pair<double, Position>>> &candidates, vector<Position> &assignment,
+                               Timer &timer, double deadline) {
+    build_slots(candidates);
+
+    double start = timer.elapsed();
+    was_exact = run(&timer, start + EXACT_SHARE * (deadline - start));
+    if (was_exact) {
+        return finish(row_match, assignment);
+    }
+    greedy_seed();
+    improve(timer, deadline);
+    return finish(heur_row, assignment);
+}
+
+// Rows with the largest gap between their best and second best option pick first,
+// each taking its cheapest free slot.
+double SparseAssignment::greedy_seed() {
+    int n = rows();
+    heur_row.assign(n, -1);
+    heur_col.assign(cols, -1);
+
+    order.clear();
+    for (int r = 0; r < n; r++) {
+        double best = INF;
+        double second = INF;
+        for (int e = row_start[r]; e < row_start[r + 1]; e++) {
+            double c = edge_cost[e];
+            if (c < best) {
+                second = best;
+                best = c;
+            }
+            else if (c < second) {
+                second = c;
+            }
+        }
+        double regret = second == INF ? INF : second - best;
+        order.push_back({-regret, r});
+    }
+    sort(order.begin(), order.end());
+
+    double cost = 0;
+    for (auto &o : order) {
+        int r = o.second;
+        int best_col = -1;
+        double best = INF;
+        for (int e = row_start[r]; e < row_start[r + 1]; e++) {
+            if (heur_col[edge_col[e]] == -1 && edge_cost[e] < best) {
+                best = edge_cost[e];
+                best_col = edge_col[e];
+            }
+        }
+        if (best_col != -1) {
+            heur_row[r] = best_col;
+            heur_col[best_col] = r;
+            cost += best;
+        }
+    }
+    return cost;
+}
+
+// Local search over the greedy matching: move a row onto a cheaper free slot,
+// or swap slots with the row holding a cheaper one when that lowers the total.
+double SparseAssignment::improve(Timer &timer, double deadline) {
+    int n = rows();
+
+    // per row copies of the edges sorted by column so swaps can look costs up
+    sorted_col.assign(edge_col.begin(), edge_col.end());
+    sorted_cost.assign(edge_cost.begin(), edge_cost.end());
+    for (int r = 0; r < n; r++) {
+        order.clear();
+        for (int e = row_start[r]; e < row_start[r + 1]; e++) {
+            order.push_back({(double)edge_col[e], e});
+        }
+        sort(order.begin(), order.end());
+        for (int k = 0; k < (int)order.size(); k++) {
+            sorted_col[row_start[r] + k] = edge_col[order[k].second];
+            sorted_cost[row_start[r] + k] = edge_cost[order[k].second];
+        }
+    }
+    auto lookup = [&](int r, int c) -> double {
+        auto first = sorted_col.begin() + row_start[r];
+        auto last = sorted_col.begin() + row_start[r + 1];
+        auto it = lower_bound(first, last, c);
+        if (it == last || *it != c) return INF;
+        return sorted_cost[it - sorted_col.begin()];
+    };
+
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        for (int a = 0; a < n; a++) {
+            if (timer.elapsed() > deadline) break;
+            int ca = heur_row[a];
+            double cur_a = ca == -1 ? INF : lookup(a, ca);
+            for (int e = row_start[a]; e < row_start[a + 1]; e++) {
+                int j = sorted_col[e];
+                double c = sorted_cost[e];
+                if (j == ca || c >= cur_a) continue;
+                int b = heur_col[j];
+                if (b == -1) {
+                    if (ca != -1) heur_col[ca] = -1;
+                    heur_row[a] = j;
+                    heur_col[j] = a;
+                }
+                else {
+                    if (ca == -1) continue;
+                    double b_new = lookup(b, ca);
+                    if (c + b_new >= cur_a + lookup(b, j)) continue;
+                    heur_row[a] = j;
+                    heur_col[j] = a;
+                    heur_row[b] = ca;
+                    heur_col[ca] = b;
+                }
+                ca = j;
+                cur_a = c;
+                improved = true;
+            }
+        }
+        if (timer.elapsed() > deadline) break;
+    }
+
+    double cost = 0;
+    for (int r = 0; r < n; r++) {
+        if (heur_row[r] != -1) cost += lookup(r, heur_row[r]);
+    }
+    return cost;
+}
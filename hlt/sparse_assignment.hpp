@@ -0,0 +1,99 @@
+#pragma once
+
+#include "types.hpp"
+#include "position.hpp"
+
+#include <vector>
+#include <utility>
+
+struct Timer;
+
+using namespace std;
+namespace hlt {
+
+    // Min cost assignment over sparse per-row edge lists (successive shortest
+    // paths with potentials, i.e. a sparse Jonker-Volgenant). Memory is
+    // O(rows + cols + edges) instead of the rows x cols matrix the hungarian needs.
+    class SparseAssignment {
+    public:
+        // Builds the problem row by row. Columns are plain slot indices.
+        void reset(int cols);
+        void add_edge(int col, double cost);
+        void end_row();
+
+        // assignment[row] is the matched column or -1 if the row has no free candidate.
+        double solve(vector<int> &assignment);
+
+        // Each row lists (cost, position) candidates. A position listed k times by some row
+        // owns k slots, so up to k rows can be matched to it (the collision target trick).
+        double solve(const vector<vector<pair<double, Position>>> &candidates, vector<Position> &assignment);
+
+        // Anytime variant for when the solve has a hard time slice. The exact solve
+        // gets EXACT_SHARE of the time up to deadline (timer.elapsed() based); only
+        // if it cannot finish in that is a regret ordered greedy matching built and
+        // improved with swaps and moves onto free slots until deadline. Always
+        // returns a complete result.
+        double solve(const vector<vector<pair<double, Position>>> &candidates, vector<Position> &assignment,
+                     Timer &timer, double deadline);
+
+        static constexpr double EXACT_SHARE = 0.8;
+
+        // Whether the last anytime solve finished the exact pass.
+        bool was_exact = true;
+
+        int rows() const {
+            return (int)row_start.size() - 1;
+        }
+
+    private:
+        bool augment(int root);
+
+        // Exact pass; gives up (returning false) once the deadline passes.
+        bool run(Timer *timer, double deadline);
+
+        double greedy_seed();
+
+        double improve(Timer &timer, double deadline);
+
+        double edge_cost_of(int row, int col);
+
+        double finish(const vector<int> &slots, vector<Position> &assignment);
+
+        void build_slots(const vector<vector<pair<double, Position>>> &candidates);
+
+        int cols = 0;
+        vector<int> row_start = vector<int>(1, 0);
+        vector<int> edge_col;
+        vector<double> edge_cost;
+
+        // slot bookkeeping for the position interface, indexed by y * key_width + x
+        // and left zeroed between solves so only the cells a solve touches are reset
+        vector<Position> slot_pos;
+        int key_width = 0;
+        vector<int> cell_keys;
+        vector<int> first_slot;
+        vector<int> slot_count;
+        vector<int> row_uses;
+
+        // solver state
+        vector<double> u;
+        vector<double> v;
+        vector<int> row_match;
+        vector<int> col_match;
+
+        // heuristic matching for the anytime solve, plus per row edges sorted by column
+        vector<int> heur_row;
+        vector<int> heur_col;
+        vector<int> sorted_col;
+        vector<double> sorted_cost;
+        vector<pair<double, int>> order;
+
+        // per augmentation scratch, reset through `touched`
+        vector<double> dist;
+        vector<int> pred;
+        vector<char> done;
+        vector<int> touched;
+        vector<int> finalized;
+        vector<pair<double, int>> heap;
+    };
+}
@@ -0,0 +1,71 @@
+#include "thread_pool.hpp"
+
+using namespace hlt;
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0) {
+        threads = (int)thread::hardware_concurrency();
+    }
+    for (int i = 1; i < threads; i++) {
+        workers.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        unique_lock<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &t : workers) {
+        t.join();
+    }
+}
+
+void ThreadPool::drain(int worker) {
+    while (true) {
+        int task;
+        {
+            unique_lock<mutex> guard(lock);
+            if (next_task >= job_tasks) return;
+            task = next_task++;
+        }
+        (*job)(task, worker);
+    }
+}
+
+void ThreadPool::work(int worker) {
+    long long seen = 0;
+    while (true) {
+        {
+            unique_lock<mutex> guard(lock);
+            wake.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            busy++;
+        }
+        drain(worker);
+        {
+            unique_lock<mutex> guard(lock);
+            if (--busy == 0) finished.notify_all();
+        }
+    }
+}
+
+void ThreadPool::run(int tasks, const function<void(int, int)> &fn) {
+    {
+        unique_lock<mutex> guard(lock);
+        job = &fn;
+        job_tasks = tasks;
+        next_task = 0;
+        generation++;
+    }
+    wake.notify_all();
+    drain(0);
+
+    // wait for workers still finishing a task, then retire the job
+    unique_lock<mutex> guard(lock);
+    finished.wait(guard, [&] { return busy == 0; });
+    job = nullptr;
+    job_tasks = 0;
+}
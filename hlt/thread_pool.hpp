@@ -0,0 +1,47 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+namespace hlt {
+
+    // Fixed set of worker threads for parallel loops. The calling thread joins
+    // in as worker 0, so a pool of size 1 simply runs everything inline.
+    class ThreadPool {
+    public:
+        // threads <= 0 picks the hardware concurrency.
+        explicit ThreadPool(int threads = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        int size() const {
+            return (int)workers.size() + 1;
+        }
+
+        // Calls fn(task, worker) for every task in [0, tasks) and returns once all
+        // are done. Tasks are handed out in order; worker is in [0, size()).
+        void run(int tasks, const function<void(int, int)> &fn);
+
+    private:
+        void work(int worker);
+        void drain(int worker);
+
+        vector<thread> workers;
+        mutex lock;
+        condition_variable wake;
+        condition_variable finished;
+
+        const function<void(int, int)> *job = nullptr;
+        int job_tasks = 0;
+        int next_task = 0;
+        int busy = 0;
+        long long generation = 0;
+        bool stopping = false;
+    };
+}
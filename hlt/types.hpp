@@ -39,6 +39,50 @@ namespace hlt {
         VVI dist;
         VVP parent;
         VVI turns;
+        // moves from the source along parent, -1 if parent never reaches it
+        VVI depth;
+        // first step out of the source towards each cell, STILL at the source
+        std::vector<std::vector<Direction>> first;
+    };
+
+    // Read-only view of a BFSR for path queries. Holds a pointer, so it is free
+    // to pass by value; the BFSR has to outlive it.
+    class PathView {
+    public:
+        PathView(const BFSR &bfs) : bfs(&bfs) {}
+
+        Position parent(Position p) const {
+            return bfs->parent[p.x][p.y];
+        }
+
+        int depth(Position p) const {
+            return bfs->depth[p.x][p.y];
+        }
+
+        Direction first_move(Position p) const {
+            return bfs->first[p.x][p.y];
+        }
+
+        // source..dest into out, or {source, {-1, -1}} when dest has no path
+        void trace(Position source, Position dest, std::vector<Position> &out) const {
+            out.clear();
+            int d = depth(dest);
+            if (d < 0) {
+                out.push_back(source);
+                out.push_back(Position{-1, -1});
+                return;
+            }
+            out.resize(d + 1);
+            Position curr = dest;
+            for (int i = d; i > 0; i--) {
+                out[i] = curr;
+                curr = parent(curr);
+            }
+            out[0] = source;
+        }
+
+    private:
+        const BFSR *bfs;
     };
 
     // COLLISION TERMS
@@ -0,0 +1,7 @@
+#include "utils.hpp"
+
+double getTime() {
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}